@@ -39,6 +39,8 @@ dist_kernel_include_HEADERS =		        \
   include/urbi/kernel/utypes.hh
 
 dist_object_include_HEADERS =                   \
+  include/urbi/object/allocator.hh              \
+  include/urbi/object/allocator.hxx             \
   include/urbi/object/any-to-boost-function.hh  \
   include/urbi/object/barrier.hh                \
   include/urbi/object/centralized-slots.hh      \
@@ -66,6 +68,8 @@ dist_object_include_HEADERS =                   \
   include/urbi/object/fwd.hh                    \
   include/urbi/object/global.hh                 \
   include/urbi/object/hash.hh                   \
+  include/urbi/object/hybrid-slots.hh           \
+  include/urbi/object/hybrid-slots.hxx          \
   include/urbi/object/job.hh                    \
   include/urbi/object/list.hh                   \
   include/urbi/object/list.hxx                  \
@@ -73,6 +77,8 @@ dist_object_include_HEADERS =                   \
   include/urbi/object/lobby.hxx                 \
   include/urbi/object/location.hh               \
   include/urbi/object/location.hxx              \
+  include/urbi/object/lookup-cache.hh           \
+  include/urbi/object/lookup-cache.hxx          \
   include/urbi/object/matrix.hh                 \
   include/urbi/object/matrix.hxx                \
   include/urbi/object/object.hh                 \
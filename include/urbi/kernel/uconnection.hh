@@ -247,6 +247,12 @@ namespace kernel
     /// The state of the connection.
     bool blocked_;
 
+    /// The time stamp (in ms) of the last tagged message, and its
+    /// rendering ("[00001234"), reused until the time changes.
+    libport::utime_t stamp_time_;
+    char stamp_[32];
+    size_t stamp_size_;
+
     /// True when the connection is reading to send/receive data (usualy
     /// set at "true" on start).
     bool active_;
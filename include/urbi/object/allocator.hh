@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2012, Gostai S.A.S.
+ *
+ * This software is provided "as is" without warranty of any kind,
+ * either expressed or implied, including but not limited to the
+ * implied warranties of fitness for a particular purpose.
+ *
+ * See the LICENSE file for more information.
+ */
+
+/**
+ ** \file urbi/object/allocator.hh
+ ** \brief Definition of object::SizeClassAllocator.
+ */
+
+#ifndef OBJECT_ALLOCATOR_HH
+# define OBJECT_ALLOCATOR_HH
+
+# include <cstddef>
+# include <string>
+# include <vector>
+
+# include <urbi/export.hh>
+
+namespace urbi
+{
+  namespace object
+  {
+    /// Segregated pools of fixed-size chunks, one per size class.
+    ///
+    /// Sizes are rounded up to a multiple of granularity, so that each
+    /// class of object only pays for its own size.  Chunks are carved in
+    /// blocks and recycled through per-class free lists: allocation and
+    /// release are O(1).  Memory is never given back to the system.
+    ///
+    /// Not thread safe: objects are created and destroyed by the kernel
+    /// thread only.
+    class URBI_SDK_API SizeClassAllocator
+    {
+    public:
+      /// Granularity of the size classes.
+      static const size_t granularity = 16;
+      /// Larger objects are handed to ::operator new.
+      static const size_t max_size = 1024;
+
+      static void* allocate(size_t size);
+      static void deallocate(void* p, size_t size);
+
+    private:
+      /// The index of the size class of \a size.
+      static size_t size_class(size_t size);
+      /// Feed the free list of size class \a c with a new block.
+      static void refill(size_t c);
+
+      struct Chunk
+      {
+        Chunk* next;
+      };
+      /// The free lists.
+      static Chunk* free_[max_size / granularity];
+    };
+
+    /// Allocation counters of a C++ class of objects.
+    ///
+    /// Meant to be used as static member only.
+    struct URBI_SDK_API AllocationStats
+    {
+      /// Register the counters of class \a name, of size \a size.
+      AllocationStats(const std::string& name, size_t size);
+      ~AllocationStats();
+
+      void allocated();
+      void released();
+
+      /// The class name.
+      std::string name;
+      /// sizeof the class.
+      size_t size;
+      /// Number of instances currently alive.
+      size_t live;
+      /// Maximum of live.
+      size_t peak;
+      /// Total number of allocations.
+      size_t allocations;
+
+      /// All the registered counters.
+      typedef std::vector<AllocationStats*> instances_type;
+      static instances_type& instances();
+    };
+  }
+}
+
+# include <urbi/object/allocator.hxx>
+
+#endif // !OBJECT_ALLOCATOR_HH
@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2012, Gostai S.A.S.
+ *
+ * This software is provided "as is" without warranty of any kind,
+ * either expressed or implied, including but not limited to the
+ * implied warranties of fitness for a particular purpose.
+ *
+ * See the LICENSE file for more information.
+ */
+
+/**
+ ** \file urbi/object/allocator.hxx
+ ** \brief Inline implementation of object::SizeClassAllocator.
+ */
+
+#ifndef OBJECT_ALLOCATOR_HXX
+# define OBJECT_ALLOCATOR_HXX
+
+# include <new>
+
+# include <urbi/object/allocator.hh>
+
+namespace urbi
+{
+  namespace object
+  {
+    /*---------------------.
+    | SizeClassAllocator.  |
+    `---------------------*/
+
+    inline size_t
+    SizeClassAllocator::size_class(size_t size)
+    {
+      return (size + granularity - 1) / granularity - 1;
+    }
+
+    inline void*
+    SizeClassAllocator::allocate(size_t size)
+    {
+      if (max_size < size)
+        return ::operator new(size);
+      size_t c = size_class(size);
+      if (!free_[c])
+        refill(c);
+      Chunk* res = free_[c];
+      free_[c] = res->next;
+      return res;
+    }
+
+    inline void
+    SizeClassAllocator::deallocate(void* p, size_t size)
+    {
+      if (!p)
+        return;
+      if (max_size < size)
+        return ::operator delete(p);
+      size_t c = size_class(size);
+      Chunk* chunk = static_cast<Chunk*>(p);
+      chunk->next = free_[c];
+      free_[c] = chunk;
+    }
+
+
+    /*------------------.
+    | AllocationStats.  |
+    `------------------*/
+
+    inline void
+    AllocationStats::allocated()
+    {
+      ++allocations;
+      if (peak < ++live)
+        peak = live;
+    }
+
+    inline void
+    AllocationStats::released()
+    {
+      --live;
+    }
+  }
+}
+
+#endif // !OBJECT_ALLOCATOR_HXX
@@ -14,6 +14,7 @@
 # include <libport/containers.hh>
 # include <iostream>
 
+# include <urbi/object/lookup-cache.hxx>
 # include <urbi/object/object.hh>
 
 namespace urbi
@@ -110,6 +111,8 @@ namespace urbi
       if (p.second)
       {
         ++owner->slots_.size_;
+        // The new slot may shadow an inherited one.
+        LookupCache::invalidate();
         return true;
       }
       else if (overwrite)
@@ -138,6 +141,7 @@ namespace urbi
 	return false;
       loc_index_.erase(it);
       --owner->slots_.size_;
+      LookupCache::invalidate();
       return true;
     }
 
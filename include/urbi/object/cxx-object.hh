@@ -17,6 +17,7 @@
 
 # include <libport/preproc.hh>
 
+# include <urbi/object/allocator.hh>
 # include <urbi/object/object.hh>
 # include <urbi/version-check.hh>
 
@@ -39,6 +40,9 @@
     static ::libport::intrusive_ptr<Name> proto;                        \
     virtual bool valid_proto(const ::urbi::object::Object& o) const;    \
     virtual void* as_dispatch_(const std::type_info* requested);        \
+    static void* operator new(size_t size);                             \
+    static void operator delete(void* p, size_t size);                  \
+    static ::urbi::object::AllocationStats allocation_stats;            \
     ATTRIBUTE_ALWAYS_INLINE                                             \
     bool                                                                \
     as_check_(const std::type_info* req)                                \
@@ -87,6 +91,23 @@
   Name::as_dispatch_(const std::type_info* requested)                   \
   {                                                                     \
     return this->as_check_(requested) ? this : 0;                       \
+  }                                                                     \
+                                                                        \
+  ::urbi::object::AllocationStats                                       \
+  Name::allocation_stats(#Name, sizeof(Name));                          \
+                                                                        \
+  void*                                                                 \
+  Name::operator new(size_t size)                                       \
+  {                                                                     \
+    allocation_stats.allocated();                                       \
+    return ::urbi::object::SizeClassAllocator::allocate(size);          \
+  }                                                                     \
+                                                                        \
+  void                                                                  \
+  Name::operator delete(void* p, size_t size)                           \
+  {                                                                     \
+    allocation_stats.released();                                        \
+    ::urbi::object::SizeClassAllocator::deallocate(p, size);            \
   }                                                                     \
   Name::Name(const ::urbi::object::FirstPrototypeFlag&)
 
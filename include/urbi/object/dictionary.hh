@@ -52,6 +52,9 @@ namespace urbi
       value_type& value_get();
       void key_check(rObject key) const;
 
+      virtual void references_get(references_type& res) const;
+      virtual void references_clear();
+
       /// Urbi methods
       rDictionary clear();
       bool empty() const;
@@ -74,6 +74,7 @@ namespace urbi
     Macro(Primitive);                           \
     Macro(Process);                             \
     Macro(Profile);                             \
+    Macro(PubSub);                              \
     Macro(Regexp);                              \
     Macro(Semaphore);                           \
     Macro(Server);                              \
@@ -81,6 +82,7 @@ namespace urbi
     Macro(Slot);                                \
     Macro(Stream);                              \
     Macro(String);                              \
+    Macro(Subscriber);                          \
     Macro(Subscription);                        \
     Macro(Tag);                                 \
     Macro(UConnection);                         \
@@ -90,6 +92,8 @@ namespace urbi
     class Slot;
     typedef libport::intrusive_ptr<Slot> rSlot;
 
+    class LookupCache;
+
 # define FWD_DECL(Class)                                \
     class Class;                                        \
     typedef libport::intrusive_ptr<Class> r ## Class    \
@@ -0,0 +1,141 @@
+/*
+ * Copyright (C) 2012, Gostai S.A.S.
+ *
+ * This software is provided "as is" without warranty of any kind,
+ * either expressed or implied, including but not limited to the
+ * implied warranties of fitness for a particular purpose.
+ *
+ * See the LICENSE file for more information.
+ */
+
+/**
+ ** \file urbi/object/hybrid-slots.hh
+ ** \brief Definition of object::HybridSlots.
+ */
+
+#ifndef OBJECT_HYBRID_SLOTS_HH
+# define OBJECT_HYBRID_SLOTS_HH
+
+# include <utility>
+# include <vector>
+
+# include <boost/unordered_map.hpp>
+
+# include <libport/hash.hh>
+# include <libport/symbol.hh>
+
+# include <urbi/object/fwd.hh>
+# include <urbi/export.hh>
+
+namespace urbi
+{
+  namespace object
+  {
+    /// Per-object slot storage.
+    ///
+    /// The slots are kept in a vector owned by the object, scanned
+    /// linearly as long as they are few.  Past index_threshold slots,
+    /// a hash table mapping names to positions in the vector is added.
+    /// The interface is the one of CentralizedSlots, so that both can
+    /// be selected at configure time.
+    class URBI_SDK_API HybridSlots
+    {
+
+      /*---------------.
+      | Type aliases.  |
+      `---------------*/
+
+    public:
+      HybridSlots();
+      /// Slots are not copied along with their owner.
+      HybridSlots(const HybridSlots&);
+      HybridSlots& operator=(const HybridSlots&);
+      ~HybridSlots();
+
+      /// The slot type
+      typedef rObject value_type;
+      /// The key type
+      typedef libport::Symbol key_type;
+      /// The location of a slot
+      typedef std::pair<Object*, libport::Symbol> location_type;
+      /// A slot and its location
+      typedef std::pair<location_type, value_type> q_slot_type;
+
+      /// The iterator type
+      typedef q_slot_type* iterator;
+      /// The const iterator type
+      typedef const q_slot_type* const_iterator;
+
+      /// Number of slots above which lookups use a hash table.
+      static const unsigned index_threshold = 8;
+
+    private:
+      /// The slots, in the order of their creation.
+      typedef std::vector<q_slot_type> content_type;
+      /// Position of the slots in content_type.
+      typedef boost::unordered_map<key_type, unsigned> index_type;
+
+
+      /*------.
+      | API.  |
+      `------*/
+
+    public:
+      /// Get a begin iterator.
+      static iterator begin(Object* owner);
+      /// Get a begin const iterator.
+      static const_iterator begin(const Object* owner);
+      /// Dispose of the slots of \a owner.
+      static void finalize(Object* owner);
+      /// Get a past-the-end iterator.
+      static iterator end(Object* owner);
+      /// Get a past-the-end cosnt iterator.
+      static const_iterator end(const Object* owner);
+      /// Erase \a owner's \a key slot.
+      /// @return Success status.
+      ///         I.e., false if the slot was not defined (entailing failure).
+      static bool erase(Object* owner, const key_type& key);
+      /// Get \a owner's \a key slot's value.
+      static value_type get(const Object* owner, const key_type& key);
+      /// Return whether \a owner has a \a key slot.
+      static bool has(Object* owner, const key_type& key);
+
+      /// Set \a owner's \a key slot's value to \a v.
+      /// @return Success status.
+      ///         (false iff the slot was already defined (entailing failure)).
+      static bool
+      set(Object* owner, const key_type& key, value_type v,
+          bool overwrite = false);
+
+
+      /*----------.
+      | Helpers.  |
+      `----------*/
+
+    private:
+      /// Position of \a key in the content, or -1.
+      int where(const key_type& key) const;
+
+
+      /*----------.
+      | Members.  |
+      `----------*/
+
+    private:
+      struct Storage
+      {
+        Storage();
+        ~Storage();
+        content_type content;
+        /// 0 until there are more than index_threshold slots.
+        index_type* index;
+      };
+
+      /// 0 as long as there are no slots, which is the case of most
+      /// objects: it keeps slot-less objects small.
+      Storage* storage_;
+    };
+  }
+}
+
+#endif // !OBJECT_HYBRID_SLOTS_HH
@@ -0,0 +1,151 @@
+/*
+ * Copyright (C) 2012, Gostai S.A.S.
+ *
+ * This software is provided "as is" without warranty of any kind,
+ * either expressed or implied, including but not limited to the
+ * implied warranties of fitness for a particular purpose.
+ *
+ * See the LICENSE file for more information.
+ */
+
+#ifndef OBJECT_HYBRID_SLOTS_HXX
+# define OBJECT_HYBRID_SLOTS_HXX
+
+# include <urbi/object/lookup-cache.hxx>
+# include <urbi/object/object.hh>
+
+namespace urbi
+{
+  namespace object
+  {
+
+    inline HybridSlots::iterator
+    HybridSlots::begin(Object* owner)
+    {
+      Storage* s = owner->slots_.storage_;
+      return s && !s->content.empty() ? &s->content.front() : 0;
+    }
+
+    inline HybridSlots::const_iterator
+    HybridSlots::begin(const Object* owner)
+    {
+      return begin(const_cast<Object*>(owner));
+    }
+
+    inline HybridSlots::iterator
+    HybridSlots::end(Object* owner)
+    {
+      Storage* s = owner->slots_.storage_;
+      return s && !s->content.empty() ? &s->content.front() + s->content.size()
+                                      : 0;
+    }
+
+    inline HybridSlots::const_iterator
+    HybridSlots::end(const Object* owner)
+    {
+      return end(const_cast<Object*>(owner));
+    }
+
+    inline void
+    HybridSlots::finalize(Object* owner)
+    {
+      // Detach the storage first: destroying the values may trigger the
+      // destruction of other objects, that must not see ours half-done.
+      Storage* s = owner->slots_.storage_;
+      owner->slots_.storage_ = 0;
+      delete s;
+    }
+
+    inline int
+    HybridSlots::where(const key_type& key) const
+    {
+      if (!storage_)
+        return -1;
+      if (storage_->index)
+      {
+        index_type::const_iterator i = storage_->index->find(key);
+        return i == storage_->index->end() ? -1 : int(i->second);
+      }
+      const content_type& c = storage_->content;
+      for (unsigned i = 0; i < c.size(); ++i)
+        if (c[i].first.second == key)
+          return i;
+      return -1;
+    }
+
+    inline bool
+    HybridSlots::set(Object* owner,
+                     const key_type& key, value_type v, bool overwrite)
+    {
+      HybridSlots& self = owner->slots_;
+      int i = self.where(key);
+      if (i != -1)
+      {
+        if (!overwrite)
+          return false;
+        // The previous value is released when v goes out of scope, once
+        // the storage is consistent.
+        std::swap(self.storage_->content[i].second, v);
+        return true;
+      }
+
+      if (!self.storage_)
+        self.storage_ = new Storage;
+      content_type& c = self.storage_->content;
+      c.push_back(q_slot_type(location_type(owner, key), v));
+      if (index_type* index = self.storage_->index)
+        (*index)[key] = c.size() - 1;
+      else if (index_threshold < c.size())
+      {
+        index = new index_type(c.size());
+        for (unsigned j = 0; j < c.size(); ++j)
+          (*index)[c[j].first.second] = j;
+        self.storage_->index = index;
+      }
+      // The new slot may shadow an inherited one.
+      LookupCache::invalidate();
+      return true;
+    }
+
+    inline HybridSlots::value_type
+    HybridSlots::get(const Object* owner, const key_type& key)
+    {
+      const HybridSlots& self = owner->slots_;
+      int i = self.where(key);
+      return i == -1 ? value_type(0) : self.storage_->content[i].second;
+    }
+
+    inline bool
+    HybridSlots::erase(Object* owner, const key_type& key)
+    {
+      HybridSlots& self = owner->slots_;
+      int i = self.where(key);
+      if (i == -1)
+        return false;
+      content_type& c = self.storage_->content;
+      // Keep the value alive until the storage is consistent.
+      value_type v = c[i].second;
+      // Fill the hole with the last slot.
+      if (unsigned(i) != c.size() - 1)
+      {
+        c[i] = c.back();
+        if (self.storage_->index)
+          (*self.storage_->index)[c[i].first.second] = i;
+      }
+      c.pop_back();
+      if (self.storage_->index)
+        self.storage_->index->erase(key);
+      LookupCache::invalidate();
+      return true;
+    }
+
+    inline bool
+    HybridSlots::has(Object* owner, const key_type& key)
+    {
+      return owner->slots_.where(key) != -1;
+    }
+
+  }
+}
+
+#endif // !OBJECT_HYBRID_SLOTS_HXX
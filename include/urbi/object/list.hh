@@ -37,6 +37,11 @@ namespace urbi
       List(const rList& model);
       const value_type& value_get() const;
       value_type& value_get();
+      /// Declare this list as the protos of an object.
+      void is_protos_set(bool b);
+
+      virtual void references_get(references_type& res) const;
+      virtual void references_clear();
 
       // Urbi method
       /// Whether not empty.
@@ -54,6 +59,8 @@ namespace urbi
       bool empty() const;
       rObject front();
       rHash hash() const;
+      /// The value of hash(), without allocating a Hash.
+      std::size_t hash_get() const;
 
       /// Also known as pop.
       rObject removeFront();
@@ -87,6 +94,10 @@ namespace urbi
       URBI_ATTRIBUTE_ON_DEMAND_DECLARE(Event, sizeChanged);
       URBI_ATTRIBUTE_ON_DEMAND_DECLARE(Event, contentChanged);
 
+    private:
+      /// Whether this is the protos of an object.
+      bool is_protos_;
+
     public:
       static bool list_added;
     };
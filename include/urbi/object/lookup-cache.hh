@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2012, Gostai S.A.S.
+ *
+ * This software is provided "as is" without warranty of any kind,
+ * either expressed or implied, including but not limited to the
+ * implied warranties of fitness for a particular purpose.
+ *
+ * See the LICENSE file for more information.
+ */
+
+/**
+ ** \file urbi/object/lookup-cache.hh
+ ** \brief Definition of object::LookupCache.
+ */
+
+#ifndef OBJECT_LOOKUP_CACHE_HH
+# define OBJECT_LOOKUP_CACHE_HH
+
+# include <cstddef>
+
+# include <libport/symbol.hh>
+
+# include <urbi/object/fwd.hh>
+# include <urbi/export.hh>
+
+namespace urbi
+{
+  namespace object
+  {
+    /// Polymorphic inline cache of the slot lookups of a call site.
+    ///
+    /// An entry maps a receiver to the object in which the lookup found
+    /// the slot.  Receivers are identified either by their address
+    /// ("identity" entries), or, when they inherit the slot through a
+    /// single proto, by this proto ("shape" entries): all the instances
+    /// of a class then share the entry.
+    ///
+    /// There is no per-object bookkeeping: all the entries are
+    /// invalidated by bumping a global version, which happens on every
+    /// structural change of the object graph: creation or removal of a
+    /// slot, and modification of the protos of an object that already
+    /// had some.
+    class URBI_SDK_API LookupCache
+    {
+    public:
+      LookupCache();
+      ~LookupCache();
+
+      /// Number of receivers remembered by a call site.
+      static const unsigned size = 4;
+
+      /// The object that held slot \a k when it was looked up from
+      /// \a receiver, or 0 if unknown.  It is up to the caller to check
+      /// that the slot is still there.
+      Object* find(const Object* receiver, libport::Symbol k) const;
+
+      /// Remember that the lookup from \a receiver ended in \a owner.
+      void store(const Object* receiver, Object* owner);
+
+      /// Invalidate all the inline caches.
+      static void invalidate();
+
+      /// \name Statistics.
+      /// \{
+      /// Lookups resolved by the cache.
+      static size_t hits;
+      /// Lookups that required walking the protos.
+      static size_t misses;
+      /// Number of global invalidations.
+      static size_t invalidations;
+      /// Reset the counters.
+      static void stats_reset();
+      /// \}
+
+    private:
+      struct Entry
+      {
+        Entry();
+        /// Identity entries: the receiver, and its protos if it has
+        /// several.  Not held: an object reusing the address gets its
+        /// protos through operations that invalidate the caches.
+        const Object* receiver;
+        const objects_type* protos;
+        /// Shape entries: the sole proto of the receivers.  Held, since
+        /// it keeps alive the path to the owner.
+        rObject shape;
+        /// Where the slot was found.
+        Object* owner;
+        /// Value of version_ when the entry was filled.
+        unsigned version;
+      };
+
+      Entry entries_[size];
+      /// The entry to overwrite next.
+      unsigned next_;
+
+      /// The global version.  Entries from an older version are stale.
+      static unsigned version_;
+    };
+  }
+}
+
+#endif // !OBJECT_LOOKUP_CACHE_HH
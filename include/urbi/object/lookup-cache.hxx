@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2012, Gostai S.A.S.
+ *
+ * This software is provided "as is" without warranty of any kind,
+ * either expressed or implied, including but not limited to the
+ * implied warranties of fitness for a particular purpose.
+ *
+ * See the LICENSE file for more information.
+ */
+
+/**
+ ** \file urbi/object/lookup-cache.hxx
+ ** \brief Inline implementation of object::LookupCache.
+ */
+
+#ifndef OBJECT_LOOKUP_CACHE_HXX
+# define OBJECT_LOOKUP_CACHE_HXX
+
+# include <urbi/object/lookup-cache.hh>
+# include <urbi/object/object.hh>
+
+namespace urbi
+{
+  namespace object
+  {
+    inline
+    LookupCache::Entry::Entry()
+      : receiver(0)
+      , protos(0)
+      , shape(0)
+      , owner(0)
+      , version(0)
+    {
+    }
+
+    inline Object*
+    LookupCache::find(const Object* receiver, libport::Symbol k) const
+    {
+      for (unsigned i = 0; i < size; ++i)
+      {
+        const Entry& e = entries_[i];
+        if (e.version != version_)
+          continue;
+        if (e.shape)
+        {
+          if (!receiver->protos_
+              && receiver->proto_ == e.shape
+              && !receiver->slots_.get(receiver, k))
+            return e.owner;
+        }
+        else if (e.receiver == receiver && e.protos == receiver->protos_)
+          return e.owner;
+      }
+      return 0;
+    }
+
+    inline void
+    LookupCache::store(const Object* receiver, Object* owner)
+    {
+      // Prefer a stale entry to the round-robin victim.
+      unsigned i = 0;
+      while (i < size && entries_[i].version == version_)
+        ++i;
+      if (i == size)
+      {
+        i = next_;
+        next_ = (next_ + 1) % size;
+      }
+      Entry& e = entries_[i];
+      if (owner != receiver && !receiver->protos_ && receiver->proto_)
+      {
+        e.receiver = 0;
+        e.protos = 0;
+        e.shape = receiver->proto_;
+      }
+      else
+      {
+        e.receiver = receiver;
+        e.protos = receiver->protos_;
+        e.shape = 0;
+      }
+      e.owner = owner;
+      e.version = version_;
+    }
+
+    inline void
+    LookupCache::invalidate()
+    {
+      ++version_;
+      ++invalidations;
+    }
+  }
+}
+
+#endif // !OBJECT_LOOKUP_CACHE_HXX
@@ -20,17 +20,22 @@
 # include <iosfwd>
 # include <set>
 # include <typeinfo>
+# include <vector>
 
 # include <boost/function.hpp>
 # include <boost/shared_ptr.hpp>
 
-# include <libport/allocator-static.hh>
 # include <libport/attributes.hh>
 # include <libport/compiler.hh>
 # include <libport/intrusive-ptr.hh>
 
+# include <urbi/object/allocator.hh>
 # include <urbi/object/fwd.hh>
-# include <urbi/object/centralized-slots.hh>
+# if defined URBI_CENTRALIZED_SLOTS
+#  include <urbi/object/centralized-slots.hh>
+# else
+#  include <urbi/object/hybrid-slots.hh>
+# endif
 # include <urbi/export.hh>
 
 # define URBI_ATTRIBUTE_ON_DEMAND_DECLARE(Type, Name)   \
@@ -64,11 +69,18 @@ namespace urbi
     /// Run time values for Urbi.
     class URBI_SDK_API Object
       : public libport::RefCounted
-      , public libport::StaticallyAllocated<Object, 1024 * 4>
     {
     public:
-      /// Maximum object size for the allocator
-      static const size_t allocator_static_max_size;
+      /// \name Allocation.
+      /// \{
+      /// Objects are allocated in size classes, see SizeClassAllocator.
+      /// Bound C++ classes redefine these operators to keep their own
+      /// AllocationStats.
+      static void* operator new(size_t size);
+      static void operator delete(void* p, size_t size);
+      /// Counters of plain Objects.
+      static AllocationStats allocation_stats;
+      /// \}
 
       /// \name Ctor & dtor.
       /// \{
@@ -80,8 +92,24 @@ namespace urbi
       virtual ~Object();
       /// \}
 
-      /// The slots implementation
+      /// \name Cycle collection.
+      /// \{
+      typedef std::vector<Object*> references_type;
+      /// Append to \a res the objects we hold a reference to.  Leaving
+      /// some out is safe: the cycle collector then takes them as
+      /// referred to from elsewhere.
+      virtual void references_get(references_type& res) const;
+      /// Drop the references reported by references_get, so that an
+      /// unreachable cycle falls apart.
+      virtual void references_clear();
+      /// \}
+
+      /// The slots implementation, chosen at configure time.
+# if defined URBI_CENTRALIZED_SLOTS
       typedef CentralizedSlots slots_implem;
+# else
+      typedef HybridSlots slots_implem;
+# endif
 
       /// Type of the keys.
       typedef slots_implem::key_type key_type;
@@ -155,6 +183,10 @@ namespace urbi
       void proto_set(const rObject& o);
       /// Return the first proto
       rObject protos_get_first() const;
+      /// Whether \a p is our sole proto.
+      bool sole_proto_is(const rObject& p) const;
+      /// Whether \a p is our sole proto, and we have no local slot.
+      bool bare_instance_of(const rObject& p) const;
 
       // Use for_all_protos to access the list of protos in an efficient way.
 
@@ -181,6 +213,11 @@ namespace urbi
       /// or (0, 0) if not found.
       location_type slot_locate(key_type k, bool fallback = true) const;
 
+      /// Same as slot_locate, but first consult, and then update, the
+      /// inline cache \a cache of the call site.
+      location_type slot_locate(key_type k, bool fallback,
+                                LookupCache& cache) const;
+
       /// Same as slot_locate, but raise Exception.Lookup if not found.
       /// \throw Exception.Lookup if the lookup fails.
       location_type safe_slot_locate(key_type k) const;
@@ -189,6 +226,9 @@ namespace urbi
       /// \param name The name of the slot to search
       /// \throw Exception.Lookup if the slot isn't found.
       rObject slot_get(key_type k, bool throwOnFailure = true) const;
+      /// Same as slot_get, but use the inline cache \a cache.
+      /// \throw Exception.Lookup if the slot isn't found.
+      rObject slot_get(key_type k, LookupCache& cache) const;
       rObject slot_get_value(key_type k, bool throwOnFailure = true) const;
 
       /// Implement low-level copy-on-write.
@@ -272,7 +312,7 @@ namespace urbi
       std::ostream& id_dump(std::ostream& o) const;
       /// Report a slot and possibly its properties.
       std::ostream& slot_dump(std::ostream& o,
-                              const CentralizedSlots::q_slot_type& s,
+                              const slots_implem::q_slot_type& s,
                               int depth_max) const;
 
       /// Dump the special slots if there are.
@@ -419,6 +459,9 @@ namespace urbi
 
       location_type slot_locate_(key_type k) const;
 
+      /// The end of slot_get, once the slot \a k was located in \a loc.
+      rObject slot_get_(key_type k, location_type& loc) const;
+
       /// Our proto as long as we only have one, ie protos_ = 0.
       rObject proto_;
 
@@ -433,11 +476,17 @@ namespace urbi
 
       mutable int lookup_id_;
 
+      /// Our position among the candidates of the CycleCollector, or -1.
+      int cycle_index_;
+
     public:
       typedef boost::unordered_set<rObject> objects_set_type;
       template<class F> friend bool
       for_all_protos(const rObject& r, F& f, objects_set_type& objects);
       friend class CentralizedSlots;
+      friend class CycleCollector;
+      friend class HybridSlots;
+      friend class LookupCache;
     };
 
     /// Call f(robj) on r and all its protos hierarchy, stop if it returns true.
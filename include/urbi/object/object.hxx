@@ -30,6 +30,7 @@
 # include <libport/typelist.hh>
 
 # include <urbi/object/object.hh>
+# include <urbi/object/lookup-cache.hxx>
 
 # include <urbi/kernel/userver.hh>
 
@@ -78,6 +79,10 @@ namespace urbi
           protos_->push_back(proto_);
           proto_ = 0;
         }
+      // Giving its first proto to an object cannot invalidate a lookup
+      // made through it.
+      if (protos_)
+        LookupCache::invalidate();
       return *this;
     }
 
@@ -99,6 +104,7 @@ namespace urbi
             i = protos_->erase(i);
           else
             ++i;
+      LookupCache::invalidate();
       return *this;
     }
 
@@ -37,9 +37,6 @@ namespace urbi
     {
     private:
       URBI_CXX_OBJECT(Slot, CxxObject);
-    public:
-      /// Maximum object size for the allocator
-      static const size_t allocator_static_max_size;
 
     public:
       typedef boost::unordered_map<libport::Symbol, rObject> properties_type;
@@ -102,6 +99,10 @@ namespace urbi
       /// Whether is const.
       bool constant() const;
 
+      /// Slots are not torn down by the cycle collector: the cycles
+      /// through a slot also go through its owner, or a closure.
+      virtual void references_get(references_type& res) const;
+
 #define URBI_OBJECT_SLOT_CACHED_PROPERTY_STORE(Elem)                    \
         (*properties_)                                                  \
         [SYMBOL_EXPAND(BOOST_PP_TUPLE_ELEM(3, 1, Elem))]                \
@@ -128,39 +129,45 @@ namespace urbi
       // Get value, when getter or a uvalue is present.
       rObject value_special(Object* sender = 0, bool fromUObject = false) const;
 
-      // Changed event, created on demand.
-      ATTRIBUTE_RW(rObject, changed);
-
       /*----------------.
       | Configuration.  |
       `----------------*/
-      ATTRIBUTE_RW(bool, constant);
+    public:
+      bool constant_get() const;
+      void constant_set(bool v);
       // Disable copy on write for this slot if false.
-      ATTRIBUTE_RW(bool, copyOnWrite);
+      bool copyOnWrite_get() const;
+      void copyOnWrite_set(bool v);
       // If true, do not bridge input to output
-      ATTRIBUTE_RW(bool, split);
-      // True when we are in the getter. Used for loop detection.
-      ATTRIBUTE_RW(int, in_getter, , , , mutable);
-      // True when we are in setter, loop detection. Per-runner flag.
-      ATTRIBUTE_RW(std::vector<void*>, in_setter);
+      bool split_get() const;
+      void split_set(bool v);
       // Enable rtp mode
-      ATTRIBUTE_R(bool, rtp);
-      // True if content is a uvalue
-      ATTRIBUTE_RW(bool, has_uvalue);
+      bool rtp_get() const;
       void rtp_set(bool v);
+      /* UObject stuff: true if we are dead, ie our owner object is gone.
+       * Needed so that all the components that may hold a ref to us can
+       * know nothing more will happen and let us go.
+       */
+      bool dead_get() const;
+      void dead_set(bool v);
 
       /*------------.
       | Callbacks.  |
       `------------*/
       // Slot getter hook: val slot.get()
-      ATTRIBUTE_Rw(rObject, get);
+      rObject get_get() const;
+      void get_set(const rObject& o);
       // Slot setter hook: slot.set(val)
-      ATTRIBUTE_Rw(rObject, set);
+      rObject set_get() const;
+      void set_set(const rObject& o);
       // Owner object getter hook: val obj.get(slot)
-      ATTRIBUTE_Rw(rObject, oget);
+      rObject oget_get() const;
+      void oget_set(const rObject& o);
       // Owner object setter hook: obj.set(val, slot)
-      ATTRIBUTE_Rw(rObject, oset);
-      ATTRIBUTE_RW(rObject, updateHook);
+      rObject oset_get() const;
+      void oset_set(const rObject& o);
+      rObject updateHook_get() const;
+      void updateHook_set(const rObject& o);
 
       /*--------.
       | Value.  |
@@ -169,29 +176,20 @@ namespace urbi
       ATTRIBUTE_RW(rObject, value);
       // aka 'sensor' value, what we expose to the external world
       ATTRIBUTE_RW(rObject, output_value);
-      // Constrain value to this type if set
-      ATTRIBUTE_RW(rObject, type);
       ATTRIBUTE_RW(ufloat, timestamp);
-      ATTRIBUTE_RW(ufloat, rangemax);
-      ATTRIBUTE_RW(ufloat, rangemin);
-
-      /* UObject stuff: true if we are dead, ie our owner object is gone.
-       * Needed so that all the components that may hold a ref to us can
-       * know nothing more will happen and let us go.
-       */
-      ATTRIBUTE_RW(bool, dead);
+    public:
+      // Constrain value to this type if set
+      rObject type_get() const;
+      void type_set(const rObject& o);
+      ufloat rangemax_get() const;
+      void rangemax_set(ufloat v);
+      ufloat rangemin_get() const;
+      void rangemin_set(ufloat v);
 
       /*-----------------.
       | Push-pull loop.  |
       `-----------------*/
-
-      /* Set to true if a push-pull loop is running.
-       * It gets activated when a getter is present, and someone registers
-       * to one of the change notification mechanisms.
-       * In this case the code 'loop getSlotValue("theslot")' is periodicaly
-       * called.
-       */
-      ATTRIBUTE_RW(bool, push_pull_loop);
+    protected:
       /* Check if there is a push_pull_loop. Must be called when the first
        * registration occurrs on each notify-change backend(at, connections)
        * Return true if a push-pull loop was activated.
@@ -203,20 +201,70 @@ namespace urbi
       /*--------------.
       | Bypass mode.  |
       `--------------*/
-      // Tag used to notify tasks blocked in a read on a slot in bypass mode
-      ATTRIBUTE_RW(rObject, waiter_tag, , , , mutable);
-      // on-demand creation of waiter_tag_
+      // on-demand creation of the tag used to notify tasks blocked in a
+      // read on a slot in bypass mode.
       rTag waiter_tag() const;
-      // Number of runners blocked using waiter_tag.
-      ATTRIBUTE_RW(unsigned int, waiter_count, , , , mutable);
       // Check and unlock getters stuck waiting for bypass-mode write.
       void check_waiters();
+
+      /*------------.
+      | Extension.  |
+      `------------*/
+    private:
+      /// What only getters, setters, change notification and UObjects
+      /// need.  Allocated on first use, so that most slots are reduced
+      /// to their value and flags.
+      struct Extension
+      {
+        Extension();
+        // Changed event, created on demand.
+        rObject changed;
+        rObject get;
+        rObject set;
+        rObject oget;
+        rObject oset;
+        rObject updateHook;
+        rObject type;
+        // Tag used to notify tasks blocked in a read on a slot in
+        // bypass mode
+        rObject waiter_tag;
+        ufloat rangemax;
+        ufloat rangemin;
+        // Jobs in the setter, loop detection.
+        std::vector<void*> in_setter;
+        // Number of runners blocked using waiter_tag.
+        unsigned int waiter_count;
+        // Depth of getter calls. Used for loop detection.
+        int in_getter;
+      };
+      /// The extension, created if needed.
+      Extension& ext() const;
+      mutable Extension* ext_;
+
+      bool constant_ : 1;
+      bool copyOnWrite_ : 1;
+      bool split_ : 1;
+      bool rtp_ : 1;
+      // True if content is a uvalue
+      bool has_uvalue_ : 1;
+      bool dead_ : 1;
+      /* Set to true if a push-pull loop is running.
+       * It gets activated when a getter is present, and someone registers
+       * to one of the change notification mechanisms.
+       * In this case the code 'loop getSlotValue("theslot")' is periodicaly
+       * called.
+       */
+      bool push_pull_loop_ : 1;
     };
 
     typedef libport::intrusive_ptr<Slot> rSlot;
   }
 }
 
-# include <urbi/object/centralized-slots.hxx>
+# if defined URBI_CENTRALIZED_SLOTS
+#  include <urbi/object/centralized-slots.hxx>
+# else
+#  include <urbi/object/hybrid-slots.hxx>
+# endif
 # include <urbi/object/cxx-object.hxx>
 #endif
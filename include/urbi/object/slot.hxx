@@ -11,6 +11,8 @@
 #ifndef OBJECT_SLOT_HXX
 # define OBJECT_SLOT_HXX
 
+# include <limits>
+
 # include <urbi/object/slot.hh>
 # include <urbi/object/cxx-conversions.hh>
 # include <urbi/runner/raise.hh>
@@ -29,10 +31,11 @@ namespace urbi
   {
     inline
     Slot::Slot()
-      : constant_(false)
+      : value_(object::void_class)
+      , ext_(0)
+      , constant_(false)
       , copyOnWrite_(true)
       , has_uvalue_(false)
-      , value_(object::void_class)
     {
       Ward w(this);
       if (!proto)
@@ -51,6 +54,7 @@ namespace urbi
     inline
     Slot::~Slot()
     {
+      delete ext_;
     }
 
     template <typename T>
@@ -97,6 +101,64 @@ namespace urbi
       return constant_;
     }
 
+    inline
+    Slot::Extension&
+    Slot::ext() const
+    {
+      if (!ext_)
+        ext_ = new Extension;
+      return *ext_;
+    }
+
+#define URBI_OBJECT_SLOT_FLAG(Name)             \
+    inline                                      \
+    bool                                        \
+    Slot::Name ## _get() const                  \
+    {                                           \
+      return Name ## _;                         \
+    }                                           \
+                                                \
+    inline                                      \
+    void                                        \
+    Slot::Name ## _set(bool v)                  \
+    {                                           \
+      Name ## _ = v;                            \
+    }
+
+    URBI_OBJECT_SLOT_FLAG(constant)
+    URBI_OBJECT_SLOT_FLAG(copyOnWrite)
+    URBI_OBJECT_SLOT_FLAG(dead)
+    URBI_OBJECT_SLOT_FLAG(split)
+#undef URBI_OBJECT_SLOT_FLAG
+
+    inline
+    bool
+    Slot::rtp_get() const
+    {
+      return rtp_;
+    }
+
+    // Reading an extension field does not allocate the extension.
+#define URBI_OBJECT_SLOT_EXTENSION_GET(Type, Name, Default)     \
+    inline                                                      \
+    Type                                                        \
+    Slot::Name ## _get() const                                  \
+    {                                                           \
+      return ext_ ? ext_->Name : Type(Default);                 \
+    }
+
+    URBI_OBJECT_SLOT_EXTENSION_GET(rObject, get, 0)
+    URBI_OBJECT_SLOT_EXTENSION_GET(rObject, oget, 0)
+    URBI_OBJECT_SLOT_EXTENSION_GET(rObject, oset, 0)
+    URBI_OBJECT_SLOT_EXTENSION_GET(rObject, set, 0)
+    URBI_OBJECT_SLOT_EXTENSION_GET(rObject, type, 0)
+    URBI_OBJECT_SLOT_EXTENSION_GET(rObject, updateHook, 0)
+    URBI_OBJECT_SLOT_EXTENSION_GET
+    (ufloat, rangemax, std::numeric_limits<ufloat>::infinity())
+    URBI_OBJECT_SLOT_EXTENSION_GET
+    (ufloat, rangemin, -std::numeric_limits<ufloat>::infinity())
+#undef URBI_OBJECT_SLOT_EXTENSION_GET
+
 /* This function is inlined for performances, but requires internal
  * headers.
  */
@@ -112,7 +174,7 @@ namespace urbi
           r->dependency_add(const_cast<Slot*>(this)->changed());
       }
        //URBI_AT_HOOK_(const_cast<Slot*>(this)->changed);
-       if ( (sender && oget_) || get_ || has_uvalue_)
+       if (has_uvalue_ || (ext_ && ((sender && ext_->oget) || ext_->get)))
          return value_special(sender, fromUObject);
        else
          return split_ ? output_value_ : value_;
@@ -12,6 +12,8 @@
 #define URBI_OBJECT_SUBSCRIPTION_HH
 
 # include <boost/function.hpp>
+# include <deque>
+
 # include <boost/signal.hpp>
 
 # include <urbi/object/cxx-object.hh>
@@ -72,6 +74,12 @@ namespace urbi
     ATTRIBUTE_RW(int, maxParallelEvents);
     /// Min time interval between two calls
     ATTRIBUTE_RW(ufloat, minInterval);
+    /** If positive, asynchronous notifications are queued and processed
+     * in order by a single job, instead of a job each.  At most
+     * queueSize notifications are kept, the oldest being dropped: with
+     * 1, only the latest payload is processed.  0 or less: no queue.
+     */
+    ATTRIBUTE_RW(int, queueSize);
 
 
     // Statistics
@@ -112,6 +120,28 @@ namespace urbi
     void run_(rExecutable e, const objects_type& args, bool detach);
     rExecutable guard, enter_, leave_;
 
+    /// Queue an asynchronous notification, see queueSize.
+    void push_(rEvent src, rList payload, EventHandler* h, bool detach,
+               const objects_type& args);
+    /// Body of worker_: process the queued notifications.
+    void drain_();
+
+    /// A pending notification: the arguments of run_sync.
+    struct Notification
+    {
+      Notification(rEvent src, rList payload, rEventHandler h, bool detach,
+                   const objects_type& args);
+      rEvent src;
+      rList payload;
+      /// Held, so that it cannot be mistaken for a newer handler.
+      rEventHandler h;
+      bool detach;
+      objects_type args;
+    };
+    std::deque<Notification> queue_;
+    /// The job processing queue_, if running.
+    runner::rJob worker_;
+
   public:
     rProfile profile;
     std::vector<boost::signals::connection> connections;
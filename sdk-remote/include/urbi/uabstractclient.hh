@@ -29,6 +29,8 @@
 # include <libport/lockable.hh>
 # include <libport/traits.hh>
 
+# include <boost/shared_ptr.hpp>
+
 # include <urbi/fwd.hh>
 # include <urbi/export.hh>
 # include <urbi/ubinary.hh>
@@ -82,6 +84,10 @@ namespace urbi
     char tag[URBI_MAX_TAG_LENGTH];
     UCallbackWrapper& callback;
     UCallbackID id;
+    /// Set when the callback is deleted, so that the dispatches still
+    /// running on a former table of callbacks skip it.  Protected by
+    /// dispatchLock.
+    bool removed;
   };
 
   //used internaly
@@ -303,7 +309,9 @@ namespace urbi
     /// \return 1 and fill tag on success, 0 on failure.
     int getAssociatedTag(UCallbackID id, char* tag);
 
-    /// Delete a callback.
+    /// Delete a callback.  Once it returned, the callback is no longer
+    /// called, unless it is called from the callback itself: it then
+    /// waits for the dispatch of the current message to finish.
     /// \return 0 if no callback with this id was found, 1 otherwise.
     int deleteCallback(UCallbackID id);
 
@@ -387,6 +395,9 @@ namespace urbi
     error_type effective_send(const std::string& buffer);
 
     libport::Lockable listLock;
+    /// Held while the callbacks are called, so that deleteCallback
+    /// waits for them.  Taken before listLock.
+    libport::Lockable dispatchLock;
 
     /// Add a callback to the list.
     UCallbackID addCallback(const char* tag, UCallbackWrapper& w);
@@ -505,8 +516,16 @@ namespace urbi
     int getCurrentTimestamp() const;
 
   private:
-    typedef std::list<UCallbackInfo> callbacks_type;
+    /// The registered callbacks, indexed by tag.
+    struct Callbacks;
+    typedef boost::shared_ptr<Callbacks> callbacks_type;
+    /// Never modified while a dispatch uses it: listLock only protects
+    /// the pointer, and writers work on a copy if the table is shared.
     callbacks_type callbacks_;
+    /// The current table, safe to dispatch on without listLock.
+    boost::shared_ptr<const Callbacks> callbacks_get();
+    /// The current table, ready to be modified.  Requires listLock.
+    Callbacks& callbacks_edit();
 
     /// A counter, used to generate unique (tag) identifiers.
     unsigned int counter_;
@@ -24,6 +24,7 @@ namespace urbi
   inline
   UCallbackInfo::UCallbackInfo(UCallbackWrapper &w)
     : callback(w)
+    , removed(false)
   {}
 
   inline
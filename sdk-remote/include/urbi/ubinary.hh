@@ -17,6 +17,8 @@
 # include <list>
 # include <string>
 
+# include <boost/shared_ptr.hpp>
+
 # include <urbi/export.hh>
 # include <urbi/uimage.hh>
 # include <urbi/usound.hh>
@@ -60,11 +62,17 @@ namespace urbi
   ///
   /// Handles its memory: the data field will be freed when the
   /// destructor is called.
+  ///
+  /// Once share() was called, the payload is reference-counted and
+  /// immutable: shallow copies (\a copy = false) share it instead of
+  /// aliasing it, and keep it alive.  Deep copies still duplicate it.
+  /// Call unshare() before modifying a shared payload.
   class URBI_SDK_API UBinary
   {
   public:
     UBinary();
-    /// Deep copy constructor.
+    /// Deep copy constructor.  If \a copy is false, alias the payload
+    /// of \a b instead, or share it if it is shared.
     UBinary(const UBinary &b, bool copy = true, bool temp = false);
     explicit UBinary(const UImage&, bool copy = true);
     explicit UBinary(const USound&, bool copy = true);
@@ -76,6 +84,14 @@ namespace urbi
     void buildMessage();
     /// Get header.
     std::string getMessage() const;
+    /// Set type, and image or sound description, from \a message.
+    void decodeMessage();
+    /// Make the payload shared by the shallow copies of this UBinary.
+    void share();
+    /// Whether the payload is shared with other UBinary.
+    bool shared() const;
+    /// Get a private copy of the payload, if it is shared.
+    void unshare();
 
     /// Clear all the buffers that were allocated by the system.
     void clear();
@@ -118,6 +134,8 @@ namespace urbi
      * some point.
      */
     bool temporary_;
+    /// If set, owner of the shared payload (common.data points into it).
+    boost::shared_ptr<void> shared_;
   };
 
   URBI_SDK_API
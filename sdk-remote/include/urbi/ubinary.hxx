@@ -29,4 +29,10 @@ namespace urbi
     free(data);
   }
 
+  inline
+  bool UBinary::shared() const
+  {
+    return shared_ && !shared_.unique();
+  }
+
 } // end namespace urbi
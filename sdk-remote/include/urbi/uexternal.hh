@@ -30,10 +30,16 @@ namespace urbi
     UEM_REPLY,  // R->K  Function call return value from a remote
     UEM_EVAL,   // R->K  Request to evaluate the string argument
     UEM_SETLOCAL, // K->R(varname, enable) mark all uvars varname as local
+    UEM_REPLYERROR, // R->K Function call exception message from a remote
   };
 
   static const std::string externalModuleTag = "__ExternalMessage__";
 
+  /// Keywords of the binaries that hold a serialized message list,
+  /// sent by the kernel instead of the printed list once the remote
+  /// asked for it.
+  static const std::string externalFrameKeyword = "uem";
+
 } // namespace urbi
 
 #endif
@@ -8,6 +8,8 @@
 
 bin_PROGRAMS +=					\
   examples/urbi-bandwidth			\
+  examples/urbi-connections			\
+  examples/urbi-flood				\
   examples/urbi-mirror				\
   examples/urbi-ping				\
   examples/urbi-play				\
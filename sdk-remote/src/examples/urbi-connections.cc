@@ -0,0 +1,167 @@
+/*
+ * Copyright (C) 2012, Gostai S.A.S.
+ *
+ * This software is provided "as is" without warranty of any kind,
+ * either expressed or implied, including but not limited to the
+ * implied warranties of fitness for a particular purpose.
+ *
+ * See the LICENSE file for more information.
+ */
+
+#include <algorithm>
+#include <vector>
+
+#include <libport/cli.hh>
+#include <libport/cstdio>
+#include <libport/foreach.hh>
+#include <libport/option-parser.hh>
+#include <libport/package-info.hh>
+#include <libport/program-name.hh>
+#include <libport/semaphore.hh>
+#include <libport/sysexits.hh>
+#include <libport/utime.hh>
+
+#include <urbi/package-info.hh>
+#include <urbi/uclient.hh>
+
+using libport::program_name;
+
+/// Posted each time a client received its pong.
+static libport::Semaphore ponged;
+
+namespace
+{
+  static
+  void
+  usage(libport::OptionParser& parser)
+  {
+    std::cout <<
+      "usage: " << program_name() << " [OPTIONS] [HOST]\n"
+      "\n"
+      "Open more and more connections to a server, and report how long\n"
+      "it takes to open them, and to get an answer on all of them.\n"
+      "\n"
+                << parser
+                << "\n"
+                << urbi::package_info().report_bugs()
+                << std::endl
+                << libport::exit(EX_OK);
+  }
+
+  static
+  void
+  version()
+  {
+    std::cout << "urbi-connections" << std::endl
+              << urbi::package_info() << std::endl
+              << libport::exit(EX_OK);
+  }
+}
+
+static urbi::UCallbackAction
+pong(const urbi::UMessage&)
+{
+  ponged++;
+  return urbi::URBI_CONTINUE;
+}
+
+/// Milliseconds elapsed since \a start.
+static double
+since(libport::utime_t start)
+{
+  return (libport::utime() - start) / 1000.;
+}
+
+int
+main(int argc, char* argv[])
+try
+{
+  libport::program_initialize(argc, argv);
+
+  libport::OptionValue
+    arg_clients("number of connections to open (1000)",
+                "clients", 'n', "CLIENTS"),
+    arg_step("number of connections opened between two reports (100)",
+             "step", 's', "STEP");
+
+  libport::OptionParser opt_parser;
+  opt_parser << "Options:"
+             << arg_clients
+	     << libport::opts::help
+	     << libport::opts::host
+	     << libport::opts::port
+	     << libport::opts::port_file
+             << arg_step
+	     << libport::opts::version;
+
+  libport::cli_args_type args = opt_parser(libport::program_arguments());
+
+  foreach(const std::string& arg, args)
+    if (arg[0] == '-')
+      libport::invalid_option(arg);
+  if (libport::opts::help.get())
+    usage(opt_parser);
+  if (libport::opts::version.get())
+    version();
+
+  std::string host = libport::opts::host.value(urbi::UClient::default_host());
+  int port = libport::opts::port.get<int>(urbi::UClient::URBI_PORT);
+  if (libport::opts::port_file.filled())
+    port = libport::file_contents_get<int>(libport::opts::port_file.value());
+  switch (args.size())
+  {
+  case 1: host = args[0];
+  case 0: break;
+  default:
+    libport::usage_error("invalid number of arguments");
+  }
+
+  unsigned clients = arg_clients.get<unsigned>(1000u);
+  unsigned step = arg_step.get<unsigned>(100u);
+  if (!clients || !step)
+    libport::usage_error("invalid null argument");
+
+  std::cout << "connections   open (ms/conn)   round-trip (ms)" << std::endl;
+  std::vector<urbi::UClient*> cs;
+  while (cs.size() < clients)
+  {
+    // Open a new batch of connections, and make sure the server
+    // answers on each of them before timing anything else.
+    libport::utime_t start = libport::utime();
+    unsigned n = std::min(step, unsigned(clients - cs.size()));
+    for (unsigned i = 0; i < n; ++i)
+    {
+      urbi::UClient* c = new urbi::UClient(host, port);
+      if (c->error())
+        std::cerr << program_name() << ": client " << cs.size()
+                  << " failed to set up" << std::endl
+                  << libport::exit(1);
+      c->setCallback(&pong, "pong");
+      c->send("var pong = Channel.new(\"pong\")|;\n"
+              "pong << 1;\n");
+      cs.push_back(c);
+    }
+    for (unsigned i = 0; i < n; ++i)
+      ponged--;
+    double open = since(start) / n;
+
+    // Then ping all of them at once.
+    start = libport::utime();
+    foreach (urbi::UClient* c, cs)
+      c->send("pong << 1;\n");
+    for (unsigned i = 0; i < cs.size(); ++i)
+      ponged--;
+    double round = since(start);
+
+    printf("%11lu   %14.3f   %15.3f\n",
+           (unsigned long) cs.size(), open, round);
+  }
+
+  foreach (urbi::UClient* c, cs)
+    delete c;
+}
+catch (const std::exception& e)
+{
+  std::cerr << program_name() << ": " << e.what() << std::endl
+            << libport::exit(EX_FAIL);
+}
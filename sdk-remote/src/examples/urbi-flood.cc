@@ -0,0 +1,167 @@
+/*
+ * Copyright (C) 2012, Gostai S.A.S.
+ *
+ * This software is provided "as is" without warranty of any kind,
+ * either expressed or implied, including but not limited to the
+ * implied warranties of fitness for a particular purpose.
+ *
+ * See the LICENSE file for more information.
+ */
+
+#include <algorithm>
+#include <vector>
+
+#include <libport/cli.hh>
+#include <libport/foreach.hh>
+#include <libport/option-parser.hh>
+#include <libport/package-info.hh>
+#include <libport/program-name.hh>
+#include <libport/semaphore.hh>
+#include <libport/sysexits.hh>
+#include <libport/utime.hh>
+
+#include <urbi/package-info.hh>
+#include <urbi/uclient.hh>
+
+using libport::program_name;
+
+/// Posted each time a client received the result of its last command.
+static libport::Semaphore done;
+
+namespace
+{
+  static
+  void
+  usage(libport::OptionParser& parser)
+  {
+    std::cout <<
+      "usage: " << program_name() << " [OPTIONS] [HOST]\n"
+      "\n"
+      "Flood a server with small commands from several connections,\n"
+      "and report the number of commands processed per second.\n"
+      "\n"
+                << parser
+                << "\n"
+                << urbi::package_info().report_bugs()
+                << std::endl
+                << libport::exit(EX_OK);
+  }
+
+  static
+  void
+  version()
+  {
+    std::cout << "urbi-flood" << std::endl
+              << urbi::package_info() << std::endl
+              << libport::exit(EX_OK);
+  }
+}
+
+static urbi::UCallbackAction
+finished(const urbi::UMessage&)
+{
+  done++;
+  return urbi::URBI_CONTINUE;
+}
+
+int
+main(int argc, char* argv[])
+try
+{
+  libport::program_initialize(argc, argv);
+
+  libport::OptionValue
+    arg_batch("number of commands per packet (100)",
+              "batch", 'b', "BATCH"),
+    arg_clients("number of concurrent connections (10)",
+                "clients", 'n', "CLIENTS"),
+    arg_count("number of commands sent by each connection (10000)",
+              "count", 'c', "COUNT");
+
+  libport::OptionParser opt_parser;
+  opt_parser << "Options:"
+             << arg_batch
+             << arg_clients
+             << arg_count
+	     << libport::opts::help
+	     << libport::opts::host
+	     << libport::opts::port
+	     << libport::opts::port_file
+	     << libport::opts::version;
+
+  libport::cli_args_type args = opt_parser(libport::program_arguments());
+
+  foreach(const std::string& arg, args)
+    if (arg[0] == '-')
+      libport::invalid_option(arg);
+  if (libport::opts::help.get())
+    usage(opt_parser);
+  if (libport::opts::version.get())
+    version();
+
+  std::string host = libport::opts::host.value(urbi::UClient::default_host());
+  int port = libport::opts::port.get<int>(urbi::UClient::URBI_PORT);
+  if (libport::opts::port_file.filled())
+    port = libport::file_contents_get<int>(libport::opts::port_file.value());
+  switch (args.size())
+  {
+  case 1: host = args[0];
+  case 0: break;
+  default:
+    libport::usage_error("invalid number of arguments");
+  }
+
+  unsigned batch = arg_batch.get<unsigned>(100u);
+  unsigned clients = arg_clients.get<unsigned>(10u);
+  unsigned count = arg_count.get<unsigned>(10000u);
+  if (!batch || !clients)
+    libport::usage_error("invalid null argument");
+
+  // Each command is a separate statement that produces no output, so
+  // that the server spends its time reading and parsing the input.
+  static const std::string command = "c += 1|;\n";
+  std::string packet;
+  for (unsigned i = 0; i < batch; ++i)
+    packet += command;
+
+  std::vector<urbi::UClient*> cs;
+  for (unsigned i = 0; i < clients; ++i)
+  {
+    urbi::UClient* c = new urbi::UClient(host, port);
+    if (c->error())
+      std::cerr << program_name() << ": client failed to set up"
+                << std::endl
+                << libport::exit(1);
+    c->setCallback(&finished, "flood");
+    c->send("var c = 0|;\n"
+            "var flood = Channel.new(\"flood\")|;\n");
+    cs.push_back(c);
+  }
+
+  libport::utime_t start = libport::utime();
+  for (unsigned sent = 0; sent < count; sent += batch)
+    foreach (urbi::UClient* c, cs)
+      if (count - sent < batch)
+        c->send(packet.substr(0, (count - sent) * command.size()));
+      else
+        c->send(packet);
+  foreach (urbi::UClient* c, cs)
+    c->send("flood << c;\n");
+  for (unsigned i = 0; i < clients; ++i)
+    done--;
+  libport::utime_t elapsed =
+    std::max(libport::utime() - start, libport::utime_t(1));
+
+  std::cout << clients * count << " commands from " << clients
+            << " connections in " << elapsed / 1000 << " ms: "
+            << double(clients) * count * 1000000 / elapsed
+            << " commands per second" << std::endl;
+
+  foreach (urbi::UClient* c, cs)
+    delete c;
+}
+catch (const std::exception& e)
+{
+  std::cerr << program_name() << ": " << e.what() << std::endl
+            << libport::exit(EX_FAIL);
+}
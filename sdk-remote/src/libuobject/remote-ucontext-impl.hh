@@ -181,6 +181,8 @@ namespace urbi
       bool dataSent;
       // Send serialized binary messages if set.
       bool serializationMode;
+      // The kernel sends binary frames, and accepts UEM_REPLYERROR.
+      bool framed;
       libport::serialize::BinaryOSerializer* oarchive;
       libport::PackageInfo::Version version;
       // Name of the hook-point UObject for UVars.
@@ -160,6 +160,7 @@ namespace urbi
       , outputStream(client)
       , dataSent(false)
       , serializationMode(false)
+      , framed(false)
       , oarchive(0)
       , sharedRTP_(0)
     {
@@ -492,7 +493,17 @@ namespace urbi
       // This method can be called by a thread from the Thread Pool because
       // it is used as a callback function.  Thus we have to declare the
       // category for the debugger used by the current thread.
-      if (e)
+      if (e && ctx->framed)
+      {
+        char type = UEM_REPLYERROR;
+        std::string message =
+          libport::format("exception caught while calling remote method: %s",
+                          e->what());
+        ctx->outputStream->flush();
+        *ctx->oarchive << type << var << message;
+        ctx->backend_->flush();
+      }
+      else if (e)
         URBI_SEND_COMMA_COMMAND_C
           (*ctx->outputStream,
            libport::format
@@ -546,11 +557,26 @@ namespace urbi
       REQUIRE(msg.type == MESSAGE_DATA,
               "Component Error: unknown message content, type %d\n",
               msg.type);
-      REQUIRE(msg.value->type == DATA_LIST,
+
+      // Binary frames hold the message list serialized.
+      const UValue* value = msg.value;
+      UValue frame;
+      if (value->type == DATA_BINARY
+          && value->binary->type == BINARY_UNKNOWN
+          && value->binary->getMessage() == externalFrameKeyword)
+      {
+        const UBinary& b = *value->binary;
+        std::istringstream is(std::string(static_cast<char*>(b.common.data),
+                                          b.common.size));
+        libport::serialize::BinaryISerializer ser(is);
+        ser >> frame;
+        value = &frame;
+      }
+      REQUIRE(value->type == DATA_LIST,
               "Component Error: unknown message content, value type %d\n",
-              msg.value->type);
+              value->type);
 
-      UList& array = *msg.value->list;
+      UList& array = *value->list;
       GD_FINFO_DUMP("Dispatching %s, first %s", array, array[0]);
       REQUIRE(array[0].type == DATA_DOUBLE,
               "Component Error: invalid server message type %d\n",
@@ -1030,6 +1056,17 @@ namespace urbi
         return;
       if (!mode)
         throw std::runtime_error("Serialization mode can not be undone");
+      // Ask the kernel to send messages as binary frames, which we
+      // don't need to parse.  Older kernels don't know them.
+      UMessage* m =
+        syncGet("if ('external'.hasLocalSlot(\"enableFrames\"))"
+                " 'external'.enableFrames(lobby) else 0", 0);
+      framed = (m
+                && m->type == MESSAGE_DATA
+                && m->value->type == DATA_DOUBLE
+                && m->value->val);
+      delete m;
+      GD_FINFO_TRACE("Binary frames: %s", framed);
       serializationMode = mode;
       // Notify the kernel, in the current mode.
       // Do not use call, we must be foreground.
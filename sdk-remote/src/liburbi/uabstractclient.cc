@@ -17,6 +17,9 @@
 #include <libport/cstdlib>
 #include <fstream>
 #include <iostream>
+#include <vector>
+
+#include <boost/unordered_map.hpp>
 
 #include <libport/format.hh>
 #include <libport/io-stream.hh>
@@ -27,6 +30,7 @@
 #include <libport/containers.hh>
 #include <libport/debug.hh>
 #include <libport/escape.hh>
+#include <libport/foreach.hh>
 #include <libport/lexical-cast.hh>
 #include <libport/lockable.hh>
 #include <libport/sys/stat.h>
@@ -143,39 +147,141 @@ namespace urbi
       bins.front().clear();
   }
 
-  inline
+  /*-----------------------------.
+  | UAbstractClient::Callbacks.  |
+  `-----------------------------*/
+
+  namespace
+  {
+    /// Release \a ci, and its callback if it was deleted.  Called when
+    /// the last table referring to \a ci is released.
+    void
+    callback_info_release(UCallbackInfo* ci)
+    {
+      if (ci->removed)
+        delete &ci->callback;
+      delete ci;
+    }
+
+    /// Order of the callbacks: the most recent first.
+    bool
+    callback_info_newer(const UCallbackInfo* lhs, const UCallbackInfo* rhs)
+    {
+      return rhs->id < lhs->id;
+    }
+  }
+
+  /// The wildcard and error callbacks match on other criteria than
+  /// the tag of the message, they are kept aside.
+  struct UAbstractClient::Callbacks
+  {
+    typedef boost::shared_ptr<UCallbackInfo> info_type;
+    /// Most recent first.
+    typedef std::vector<info_type> infos_type;
+    typedef boost::unordered_map<std::string, infos_type> tags_type;
+    typedef boost::unordered_map<UCallbackID, info_type> ids_type;
+
+    /// The list where the callbacks on \a tag are stored.
+    infos_type& infos(const char* tag);
+    /// Add \a ci.
+    void add(const info_type& ci);
+    /// Remove the callback \a id.  Return false if there is none.
+    bool remove(UCallbackID id);
+    /// Append the callbacks concerned by \a msg to \a res.
+    void matching(const UMessage& msg,
+                  std::vector<UCallbackInfo*>& res) const;
+
+    tags_type tags;
+    infos_type wildcard;
+    infos_type error;
+    ids_type ids;
+  };
+
+  UAbstractClient::Callbacks::infos_type&
+  UAbstractClient::Callbacks::infos(const char* tag)
+  {
+    if (libport::streq(tag, tag_wildcard))
+      return wildcard;
+    else if (libport::streq(tag, tag_error))
+      return error;
+    else
+      return tags[tag];
+  }
+
+  void
+  UAbstractClient::Callbacks::add(const info_type& ci)
+  {
+    infos_type& is = infos(ci->tag);
+    is.insert(is.begin(), ci);
+    ids[ci->id] = ci;
+  }
+
   bool
-  matching_tag(const UMessage& msg, const char* tag)
-  {
-    return
-      msg.tag == tag
-      || (libport::streq(tag, tag_error) && msg.type == MESSAGE_ERROR)
-      // The wild card does not match tags starting with
-      // TAG_PRIVATE_PREFIX.
-      || (libport::streq(tag, tag_wildcard)
-          && msg.tag.compare(0,
-                             sizeof TAG_PRIVATE_PREFIX - 1,
-                             TAG_PRIVATE_PREFIX));
+  UAbstractClient::Callbacks::remove(UCallbackID id)
+  {
+    ids_type::iterator i = ids.find(id);
+    if (i == ids.end())
+      return false;
+    info_type ci = i->second;
+    ids.erase(i);
+    infos_type& is = infos(ci->tag);
+    is.erase(std::find(is.begin(), is.end(), ci));
+    if (is.empty() && &is != &wildcard && &is != &error)
+      tags.erase(ci->tag);
+    return true;
   }
 
   void
-  UAbstractClient::notifyCallbacks(const UMessage& msg)
+  UAbstractClient::Callbacks::matching(const UMessage& msg,
+                                       std::vector<UCallbackInfo*>& res) const
+  {
+    tags_type::const_iterator t = tags.find(msg.tag);
+    if (t != tags.end())
+      foreach (const info_type& ci, t->second)
+        res.push_back(ci.get());
+    if (msg.type == MESSAGE_ERROR || msg.tag == tag_error)
+      foreach (const info_type& ci, error)
+        res.push_back(ci.get());
+    // The wild card does not match tags starting with
+    // TAG_PRIVATE_PREFIX.
+    if (msg.tag.compare(0,
+                        sizeof TAG_PRIVATE_PREFIX - 1,
+                        TAG_PRIVATE_PREFIX))
+      foreach (const info_type& ci, wildcard)
+        res.push_back(ci.get());
+  }
+
+  boost::shared_ptr<const UAbstractClient::Callbacks>
+  UAbstractClient::callbacks_get()
   {
     libport::BlockLock bl(listLock);
-    bool inc = true;
-    for (callbacks_type::iterator it = callbacks_.begin();
-         it != callbacks_.end();
-         inc ? it++ : it, inc = true)
-      if (matching_tag(msg, it->tag))
-      {
-        UCallbackAction ua = it->callback(msg);
-        if (ua == URBI_REMOVE)
-        {
-          delete &it->callback;
-          it = callbacks_.erase(it);
-          inc = false;
-        }
-      }
+    return callbacks_;
+  }
+
+  UAbstractClient::Callbacks&
+  UAbstractClient::callbacks_edit()
+  {
+    // Do not modify a table that a dispatch is iterating over.
+    if (!callbacks_.unique())
+      callbacks_.reset(new Callbacks(*callbacks_));
+    return *callbacks_;
+  }
+
+  void
+  UAbstractClient::notifyCallbacks(const UMessage& msg)
+  {
+    // Keep the table alive, and its callbacks, during the dispatch:
+    // the callbacks may be deleted meanwhile, possibly by themselves.
+    boost::shared_ptr<const Callbacks> callbacks = callbacks_get();
+    std::vector<UCallbackInfo*> cis;
+    callbacks->matching(msg, cis);
+    if (1 < cis.size())
+      std::sort(cis.begin(), cis.end(), callback_info_newer);
+    libport::BlockLock bl(dispatchLock);
+    foreach (UCallbackInfo* ci, cis)
+      if (!ci->removed
+          && ci->callback(msg) == URBI_REMOVE)
+        deleteCallback(ci->id);
   }
 
   UAbstractClient::UAbstractClient(const std::string& host,
@@ -185,6 +291,7 @@ namespace urbi
     : LockableOstream(new UClientStreambuf(this))
     , closed_ (false)
     , listLock()
+    , dispatchLock()
     , host_(host)
     , port_(port)
     , server_(server)
@@ -205,6 +312,7 @@ namespace urbi
     , binaryMode(false)
     , system(false)
     , init_(true)
+    , callbacks_(new Callbacks)
     , counter_(0)
     , stream_(this)
   {
@@ -599,16 +707,11 @@ namespace urbi
   int
   UAbstractClient::getAssociatedTag(UCallbackID id, char* tag)
   {
-    listLock.lock();
-    callbacks_type::iterator it =
-      std::find(callbacks_.begin(), callbacks_.end(), id);
-    if (it == callbacks_.end())
-    {
-      listLock.unlock();
+    boost::shared_ptr<const Callbacks> callbacks = callbacks_get();
+    Callbacks::ids_type::const_iterator i = callbacks->ids.find(id);
+    if (i == callbacks->ids.end())
       return 0;
-    }
-    strcpy(tag, it->tag);
-    listLock.unlock();
+    strcpy(tag, i->second->tag);
     return 1;
   }
 
@@ -616,17 +719,15 @@ namespace urbi
   int
   UAbstractClient::deleteCallback(UCallbackID id)
   {
-    listLock.lock();
-    callbacks_type::iterator it =
-      std::find(callbacks_.begin(), callbacks_.end(), id);
-    if (it == callbacks_.end())
-    {
-      listLock.unlock();
+    // Wait for the running dispatch (unless we are part of it).
+    libport::BlockLock dl(dispatchLock);
+    libport::BlockLock bl(listLock);
+    Callbacks::ids_type::const_iterator i = callbacks_->ids.find(id);
+    if (i == callbacks_->ids.end())
       return 0;
-    }
-    delete &(it->callback);
-    callbacks_.erase(it);
-    listLock.unlock();
+    // The callback is released with the last table that holds it.
+    i->second->removed = true;
+    callbacks_edit().remove(id);
     return 1;
   }
 
@@ -958,14 +1059,13 @@ namespace urbi
   UAbstractClient::addCallback(const char* tag,
                                UCallbackWrapper& w)
   {
-    listLock.lock();
-    UCallbackInfo ci(w);
-    strncpy(ci.tag, tag, URBI_MAX_TAG_LENGTH-1);
-    ci.tag[URBI_MAX_TAG_LENGTH-1]=0;
-    ci.id = ++nextId;
-    callbacks_.push_front(ci);
-    listLock.unlock();
-    return ci.id;
+    Callbacks::info_type ci(new UCallbackInfo(w), callback_info_release);
+    strncpy(ci->tag, tag, URBI_MAX_TAG_LENGTH-1);
+    ci->tag[URBI_MAX_TAG_LENGTH-1]=0;
+    libport::BlockLock bl(listLock);
+    ci->id = ++nextId;
+    callbacks_edit().add(ci);
+    return ci->id;
   }
 
   void
@@ -8,7 +8,9 @@
  * See the LICENSE file for more information.
  */
 
+#include <algorithm>
 #include <fstream>
+#include <vector>
 #include <libport/cstdlib>
 #include <libport/debug.hh>
 #include <libport/cstdio>
@@ -24,6 +26,8 @@ GD_CATEGORY(Urbi.Convert);
 #ifndef NO_IMAGE_CONVERSION
 # include <csetjmp>
 
+# include <boost/thread/tss.hpp>
+
 // It would be nice to use jpeg/jpeglib.h, but this file includes
 // jconfig.h, unqualified, which we might pick-up on the host.  So
 // don't take gratuitous chances.
@@ -36,44 +40,45 @@ namespace urbi
   {
     void*
     read_jpeg(const char* jpgbuffer, size_t jpgbuffer_size,
-              bool RGB, size_t& output_size, size_t& w, size_t& h);
+              bool RGB, size_t& output_size, size_t& w, size_t& h,
+              byte* dst = 0, size_t dst_size = 0,
+              size_t min_w = 0, size_t min_h = 0);
 
     int
     write_jpeg(const byte* src, size_t w, size_t h, bool ycrcb,
                byte* dst, size_t& sz, int quality);
 
+    /// Number of rows passed at once to libjpeg.
+    static const unsigned scanlines_batch = 16;
+
     inline byte clamp(int v)
     {
       return (v < 0     ? 0
               : 255 < v ? 255
               :           v);
     }
-
-    inline byte clamp(ufloat v)
-    {
-      return (v < 0     ? 0
-              : 255 < v ? 255
-              :           libport::rounding_cast<byte>(v));
-    }
   } // namespace
 
   int
   convertRGBtoYCbCr(const byte* in, size_t bufferSize,
                     byte* out)
   {
+    /*
+      Y  =      (0.257 * R) + (0.504 * G) + (0.098 * B) + 16
+      Cr = V =  (0.439 * R) - (0.368 * G) - (0.071 * B) + 128
+      Cb = U = -(0.148 * R) - (0.291 * G) + (0.439 * B) + 128
+
+      In 8 bit fixed point, the results are always within [16, 240]: no
+      need to clamp, and the compiler can vectorize the loop.
+    */
     for (size_t i = 0; i < bufferSize - 2; i += 3)
     {
-      ufloat r = in[i];
-      ufloat g = in[i + 1];
-      ufloat b = in[i + 2];
-      /*
-        Y  =      (0.257 * R) + (0.504 * G) + (0.098 * B) + 16
-        Cr = V =  (0.439 * R) - (0.368 * G) - (0.071 * B) + 128
-        Cb = U = -(0.148 * R) - (0.291 * G) + (0.439 * B) + 128
-      */
-      out[i]     = clamp( 0.257f * r + 0.504f * g + 0.098f * b +  16.0f);
-      out[i + 1] = clamp(-0.148f * r - 0.291f * g + 0.439f * b + 128.0f);
-      out[i + 2] = clamp( 0.439f * r - 0.368f * g - 0.071f * b + 128.0f);
+      int r = in[i];
+      int g = in[i + 1];
+      int b = in[i + 2];
+      out[i]     = (( 66 * r + 129 * g +  25 * b + 128) >> 8) +  16;
+      out[i + 1] = ((-38 * r -  74 * g + 112 * b + 128) >> 8) + 128;
+      out[i + 2] = ((112 * r -  94 * g -  18 * b + 128) >> 8) + 128;
     }
     return 1;
   }
@@ -138,13 +143,18 @@ namespace urbi
       the height that are retrieved during the convertion of the convertion
       of the data.
 
+      If \a min_w and \a min_h are not null, the image may be decoded at
+      1/2, 1/4 or 1/8 of its size, provided it remains at least that
+      large.
+
       \return 1 on success.
   */
   static
   int
   convert_jpeg_to(const byte* source, size_t sourcelen,
                   UImageFormat dest_format,
-                  byte** dest, size_t& size, size_t& w, size_t& h)
+                  byte** dest, size_t& size, size_t& w, size_t& h,
+                  size_t min_w = 0, size_t min_h = 0)
   {
     aver(dest_format == IMAGE_RGB || dest_format == IMAGE_YCbCr,
          dest_format);
@@ -154,13 +164,15 @@ namespace urbi
 
     size_t sz;
     void *destination = read_jpeg((const char*) source, sourcelen,
-                                  dest_format == IMAGE_RGB, sz, w, h);
+                                  dest_format == IMAGE_RGB, sz, w, h,
+                                  *dest, *dest ? size : 0, min_w, min_h);
     if (!destination)
     {
       size = 0;
       return 0;
     }
-    if (!*dest)
+    // Decoded in place.
+    if (destination == *dest || !*dest)
     {
       *dest = (byte*) destination;
       size = sz;
@@ -211,13 +223,9 @@ namespace urbi
   convertRGBtoGrey8_601(const byte* in, size_t bufferSize,
                         byte* out)
   {
+    // The weights sum to 256: no need to clamp.
     for (size_t j = 0, i = 0; i < bufferSize - 2; i += 3, j++)
-    {
-      ufloat r = in[i];
-      ufloat g = in[i + 1];
-      ufloat b = in[i + 2];
-      out[j]  = clamp(0.299f * r + 0.587f * g + 0.114f * b);
-    }
+      out[j] = (77 * in[i] + 150 * in[i + 1] + 29 * in[i + 2] + 128) >> 8;
     return 1;
   }
 
@@ -340,12 +348,16 @@ namespace urbi
 
       row_stride = w * 3;	/* JSAMPLEs per row in image_buffer */
 
+      // Pass the rows by batches, to save calls into libjpeg.
+      JSAMPROW rows[scanlines_batch];
       while (cinfo.next_scanline < cinfo.image_height)
       {
-        /* pointer to JSAMPLE row[s] */
-        const JSAMPLE* row =
-          (const JSAMPLE*) &src[cinfo.next_scanline * row_stride];
-        jpeg_write_scanlines(&cinfo, const_cast<JSAMPLE**>(&row), 1);
+        JDIMENSION n = std::min(JDIMENSION(scanlines_batch),
+                                cinfo.image_height - cinfo.next_scanline);
+        for (JDIMENSION i = 0; i < n; ++i)
+          rows[i] = const_cast<JSAMPLE*>
+            (&src[(cinfo.next_scanline + i) * row_stride]);
+        jpeg_write_scanlines(&cinfo, rows, n);
       }
 
       jpeg_finish_compress(&cinfo);
@@ -355,101 +367,223 @@ namespace urbi
       return sz;
     }
 
-    /*! Convert a jpeg image to YCrCb or RGB. Allocate the buffer with malloc.
-     */
-    void *read_jpeg(const char* jpgbuffer, size_t jpgbuffer_size, bool RGB,
-                    size_t& output_size, size_t& w, size_t& h)
+    /// A decompressor, reused from one image to the other: creating
+    /// one allocates its memory pools.  One per thread.
+    struct jpeg_decoder
     {
+      jpeg_decoder()
+        : created(false)
+        , source(0)
+        , buffer(0)
+      {
+        cinfo.err = jpeg_std_error(&jerr.pub);
+        jerr.pub.error_exit = urbi_jpeg_error_exit;
+      }
+
+      ~jpeg_decoder()
+      {
+        if (created)
+          jpeg_destroy_decompress(&cinfo);
+      }
+
+      /// To call once the error handler is set.
+      void
+      create()
+      {
+        if (created)
+          return;
+        jpeg_create_decompress(&cinfo);
+        source = (mem_source_mgr*)
+          (*cinfo.mem->alloc_small) ((j_common_ptr) &cinfo, JPOOL_PERMANENT,
+                                     sizeof (mem_source_mgr));
+        source->pub.skip_input_data = skip_input_data;
+        source->pub.term_source = term_source;
+        source->pub.init_source = init_source;
+        source->pub.fill_input_buffer = fill_input_buffer;
+        source->pub.resync_to_restart = jpeg_resync_to_restart;
+        cinfo.src = &source->pub;
+        created = true;
+      }
+
       struct jpeg_decompress_struct cinfo;
       struct urbi_jpeg_error_mgr jerr;
-      cinfo.err = jpeg_std_error(&jerr.pub);
-      jerr.pub.error_exit = urbi_jpeg_error_exit;
-      if (setjmp(jerr.setjmp_buffer))
+      bool created;
+      mem_source_mgr* source;
+      /// The buffer being filled if we allocated it, to reclaim on errors.
+      void* buffer;
+    };
+
+    static jpeg_decoder&
+    decoder()
+    {
+      static boost::thread_specific_ptr<jpeg_decoder> res;
+      if (!res.get())
+        res.reset(new jpeg_decoder);
+      return *res;
+    }
+
+    /*! Convert a jpeg image to YCrCb or RGB.  Decode in \a dst if it
+     *  is at least \a dst_size bytes long, otherwise allocate the buffer
+     *  with malloc.
+     *  Use DCT scaling to decode at the smallest size at least
+     *  \a min_w x \a min_h, if they are not null.
+     */
+    void *read_jpeg(const char* jpgbuffer, size_t jpgbuffer_size, bool RGB,
+                    size_t& output_size, size_t& w, size_t& h,
+                    byte* dst, size_t dst_size,
+                    size_t min_w, size_t min_h)
+    {
+      jpeg_decoder& d = decoder();
+      jpeg_decompress_struct& cinfo = d.cinfo;
+      d.buffer = 0;
+      if (setjmp(d.jerr.setjmp_buffer))
       {
         /* If we get here, the JPEG code has signaled an error.  We
-         * need to clean up the JPEG object, close the input file, and
+         * need to reset the JPEG object, reclaim the buffer, and
          * return.
          */
-        jpeg_destroy_decompress(&cinfo);
+        if (d.created)
+          jpeg_abort_decompress(&cinfo);
+        free(d.buffer);
+        d.buffer = 0;
         GD_ERROR("JPEG error!");
         return 0;
       }
-      jpeg_create_decompress(&cinfo);
-      mem_source_mgr *source = (struct mem_source_mgr *)
-        (*cinfo.mem->alloc_small) ((j_common_ptr) & cinfo, JPOOL_PERMANENT,
-                                   sizeof (mem_source_mgr));
-
-      cinfo.src = (jpeg_source_mgr *) source;
-      source->pub.skip_input_data = skip_input_data;
-      source->pub.term_source = term_source;
-      source->pub.init_source = init_source;
-      source->pub.fill_input_buffer = fill_input_buffer;
-      source->pub.resync_to_restart = jpeg_resync_to_restart;
-      source->pub.bytes_in_buffer = jpgbuffer_size;
-      source->pub.next_input_byte = (JOCTET *) jpgbuffer;
-      cinfo.out_color_space = (RGB ? JCS_RGB : JCS_YCbCr);
+      d.create();
+      d.source->pub.bytes_in_buffer = jpgbuffer_size;
+      d.source->pub.next_input_byte = (JOCTET *) jpgbuffer;
       jpeg_read_header(&cinfo, TRUE);
       cinfo.out_color_space = (RGB ? JCS_RGB : JCS_YCbCr);
+      cinfo.scale_num = 1;
+      cinfo.scale_denom = 1;
+      if (min_w && min_h)
+        for (unsigned denom = 8; 1 < denom; denom /= 2)
+          if (min_w <= (cinfo.image_width + denom - 1) / denom
+              && min_h <= (cinfo.image_height + denom - 1) / denom)
+          {
+            cinfo.scale_denom = denom;
+            break;
+          }
       jpeg_start_decompress(&cinfo);
       w = cinfo.output_width;
       h = cinfo.output_height;
-      output_size =
-        cinfo.output_width * cinfo.output_components * cinfo.output_height;
-      void *buffer = malloc(output_size);
+      size_t row_stride = cinfo.output_width * cinfo.output_components;
+      output_size = row_stride * cinfo.output_height;
+      byte* buffer = dst;
+      if (!dst || dst_size < output_size)
+        d.buffer = buffer = static_cast<byte*>(malloc(output_size));
 
+      JSAMPROW rows[scanlines_batch];
       while (cinfo.output_scanline < cinfo.output_height)
       {
-        /* jpeg_read_scanlines expects an array of pointers to scanlines.
-         * Here the array is only one element long, but you could ask for
-         * more than one scanline at a time if that's more convenient.
-         */
-        JSAMPLE* row =
-          (JSAMPLE *) &((char*) buffer)[cinfo.output_scanline
-                                        * cinfo.output_components
-                                        * cinfo.output_width];
-        jpeg_read_scanlines(&cinfo, &row, 1);
+        JDIMENSION n = std::min(JDIMENSION(scanlines_batch),
+                                cinfo.output_height - cinfo.output_scanline);
+        for (JDIMENSION i = 0; i < n; ++i)
+          rows[i] = buffer + (cinfo.output_scanline + i) * row_stride;
+        jpeg_read_scanlines(&cinfo, rows, n);
       }
       jpeg_finish_decompress(&cinfo);
-      jpeg_destroy_decompress(&cinfo);
-
+      d.buffer = 0;
       return buffer;
     }
 
 
 
-    //scale putting (scx, scy) at the center of destination image
-    void scaleColorImage(byte* src, int sw, int sh,
-                         int scx, int scy, byte* dst,
-                         int dw, int dh, ufloat sx, ufloat sy)
+    /// Position in the source of each destination pixel, along one
+    /// axis: index of the first sample and weight of the second one, in
+    /// 1/256.  Pixel centers are aligned, the borders are replicated.
+    static void
+    bilinear_map(int ss, int ds, std::vector<int>& pos, std::vector<int>& w)
+    {
+      pos.resize(ds);
+      w.resize(ds);
+      for (int d = 0; d < ds; ++d)
+      {
+        // (d + 0.5) * ss / ds - 0.5, in 1/256.
+        int f = int((2 * d + 1) * ss * 128LL / ds) - 128;
+        if (f < 0)
+          f = 0;
+        pos[d] = f >> 8;
+        w[d] = f & 255;
+        if (ss - 1 <= pos[d])
+        {
+          pos[d] = ss - 1;
+          w[d] = 0;
+        }
+      }
+    }
+
+    static void
+    scaleBilinear(const byte* src, int sw, int sh,
+                  byte* dst, int dw, int dh)
     {
-      for (int x = 0; x < dw; ++x)
-        for (int y = 0; y < dh; ++y)
+      std::vector<int> xpos, xw, ypos, yw;
+      bilinear_map(sw, dw, xpos, xw);
+      bilinear_map(sh, dh, ypos, yw);
+      for (int y = 0; y < dh; ++y)
+      {
+        const byte* up = src + ypos[y] * sw * 3;
+        const byte* down = ypos[y] + 1 < sh ? up + sw * 3 : up;
+        int wy = yw[y];
+        byte* out = dst + y * dw * 3;
+        for (int x = 0; x < dw; ++x, out += 3)
         {
-          //find the corresponding point in source image
-          ufloat fsrcx = (ufloat) (x-dw/2) / sx  + (ufloat) scx;
-          ufloat fsrcy = (ufloat) (y-dh/2) / sy  + (ufloat) scy;
-          int srcx = (int) fsrcx;
-          int srcy = (int) fsrcy;
-          if (srcx <= 0 || srcx >= sw - 1 || srcy <= 0 || srcy >= sh - 1)
-            memset(dst + (x + y * dw) * 3, 0, 3);
-          else //do the bilinear interpolation
+          int i = xpos[x] * 3;
+          int j = xpos[x] + 1 < sw ? i + 3 : i;
+          int wx = xw[x];
+          for (int c = 0; c < 3; ++c)
           {
-            ufloat xfactor = fsrcx - (ufloat) srcx;
-            ufloat yfactor = fsrcy - (ufloat) srcy;
-            for (int color = 0; color < 3; ++color)
-            {
-              ufloat up = (ufloat) src[(srcx + srcy * sw) * 3 + color]
-                * (1.0 - xfactor)
-                + (ufloat) src[(srcx + 1 + srcy * sw) * 3 + color] * xfactor;
-              ufloat down = (ufloat) src[(srcx + (srcy + 1) * sw) * 3 + color]
-                * (1.0 - xfactor)
-                + (ufloat) src[(srcx + 1 + (srcy + 1) * sw) * 3 + color]
-                * xfactor;
-              ufloat result = up * (1.0 - yfactor) + down * yfactor;
-              dst[(x + y * dw) * 3 + color] = (byte) result;
-            }
+            int u = up[i + c] * (256 - wx) + up[j + c] * wx;
+            int d = down[i + c] * (256 - wx) + down[j + c] * wx;
+            out[c] = (u * (256 - wy) + d * wy + 32768) >> 16;
           }
         }
+      }
+    }
+
+    /// Average the source pixels covered by each destination pixel.
+    /// Used when shrinking by a factor of 2 or more, where the bilinear
+    /// interpolation would skip source pixels and alias.
+    static void
+    scaleArea(const byte* src, int sw, int sh,
+              byte* dst, int dw, int dh)
+    {
+      std::vector<unsigned> sum(dw * 3);
+      std::vector<int> x0(dw + 1);
+      for (int x = 0; x <= dw; ++x)
+        x0[x] = x * sw / dw;
+      for (int y = 0; y < dh; ++y)
+      {
+        int y0 = y * sh / dh;
+        int y1 = std::max(y0 + 1, (y + 1) * sh / dh);
+        std::fill(sum.begin(), sum.end(), 0);
+        for (int sy = y0; sy < y1; ++sy)
+        {
+          const byte* row = src + sy * sw * 3;
+          for (int x = 0; x < dw; ++x)
+            for (int sx = x0[x]; sx < std::max(x0[x] + 1, x0[x + 1]); ++sx)
+              for (int c = 0; c < 3; ++c)
+                sum[x * 3 + c] += row[sx * 3 + c];
+        }
+        byte* out = dst + y * dw * 3;
+        for (int x = 0; x < dw; ++x)
+        {
+          unsigned n = (y1 - y0) * std::max(1, x0[x + 1] - x0[x]);
+          for (int c = 0; c < 3; ++c)
+            out[x * 3 + c] = (sum[x * 3 + c] + n / 2) / n;
+        }
+      }
+    }
+
+    /// Scale the 24 bit image \a src to \a dst.
+    static void
+    scaleColorImage(const byte* src, int sw, int sh,
+                    byte* dst, int dw, int dh)
+    {
+      if (2 * dw <= sw && 2 * dh <= sh)
+        scaleArea(src, sw, sh, dst, dw, dh);
+      else
+        scaleBilinear(src, sw, sh, dst, dw, dh);
     }
 
   } // anonymous namespace
@@ -487,6 +621,10 @@ namespace urbi
     // Whether data must be freed.
     bool allocated;
 
+    // The size the image will be scaled to, if known.  Compressed
+    // sources may be decoded directly at a smaller size.
+    size_t hint_width, hint_height;
+
     static bool converters_set;
   };
 
@@ -541,9 +679,9 @@ namespace urbi
     // This image is allocated by the function convertJPEG*
     // function.  width, height and size are defined by these
     // functions calls.
-    convertJPEGtoRGB(src.data, src.size,
-                     &data, size, width, height);
-    allocated = true;
+    convert_jpeg_to(src.data, src.size, IMAGE_RGB,
+                    &data, size, width, height, hint_width, hint_height);
+    allocated = data != 0;
     imageFormat = IMAGE_RGB;
   }
 
@@ -551,9 +689,9 @@ namespace urbi
   void
   PivotImage::convert_<IMAGE_JPEG, IMAGE_YCbCr>(const UImage& src)
   {
-    convertJPEGtoYCrCb(src.data, src.size,
-                       &data, size, width, height);
-    allocated = true;
+    convert_jpeg_to(src.data, src.size, IMAGE_YCbCr,
+                    &data, size, width, height, hint_width, hint_height);
+    allocated = data != 0;
     imageFormat = IMAGE_YCbCr;
   }
 
@@ -671,7 +809,12 @@ namespace urbi
 
   PivotImage::PivotImage()
     : allocated(false)
+    , hint_width(0)
+    , hint_height(0)
   {
+    // No buffer yet: in-place decoding writes through data when size
+    // is large enough.
+    init();
     if (!converters_set)
     {
       for (int i = 0; i < IMAGE_END; ++i)
@@ -694,7 +837,6 @@ namespace urbi
 #undef CASE
       converters_set = true;
     }
-    init();
   }
 
   // The image format to convert the src image first.  Depends on the
@@ -768,6 +910,8 @@ namespace urbi
 
     // uncompressed data.
     PivotImage pivot;
+    pivot.hint_width = dest.width;
+    pivot.hint_height = dest.height;
     PivotImage::conversion_type converter
       = (PivotImage::converters
          [src.imageFormat]
@@ -784,16 +928,15 @@ namespace urbi
     if (pivot.width != dest.width || pivot.height != dest.height)
     {
       byte* scaled = (byte*)malloc(dest.width * dest.height * 3);
-      scaleColorImage(pivot.data,
-                      pivot.width, pivot.height,
-                      pivot.width / 2, pivot.height / 2,
-                      scaled, dest.width, dest.height,
-                      (ufloat) dest.width / (ufloat) src.width,
-                      (ufloat) dest.height / (ufloat) src.height);
+      scaleColorImage(pivot.data, pivot.width, pivot.height,
+                      scaled, dest.width, dest.height);
       if (pivot.allocated)
         free(pivot.data);
       pivot.data = scaled;
       pivot.allocated = true;
+      pivot.width = dest.width;
+      pivot.height = dest.height;
+      pivot.size = dest.width * dest.height * 3;
     }
     // Then factor YUV<->RGB conversion if necessary
     if ((pivot.imageFormat == IMAGE_RGB && targetformat == IMAGE_YCbCr)
@@ -826,6 +969,17 @@ namespace urbi
       // We need place for the header.
       dest.size += 15;
 
+    // When the pivot is the result, hand over its buffer instead of
+    // copying it: dest.data may be reallocated anyway.
+    if (pivot.allocated && pivot.size == dest.size
+        && (dest.imageFormat == IMAGE_RGB
+            || dest.imageFormat == IMAGE_YCbCr))
+    {
+      free(dest.data);
+      dest.data = pivot.data;
+      return 1;
+    }
+
     dest.data = static_cast<byte*> (realloc(dest.data, dest.size));
     size_t dsz = dest.size;
     unsigned int plane = dest.width * dest.height;
@@ -49,6 +49,7 @@ namespace urbi
       sound = b.sound;
       message = b.message;
       type = b.type;
+      shared_ = b.shared_;
     }
   }
 
@@ -81,14 +82,44 @@ namespace urbi
   void
   UBinary::clear()
   {
-    if (allocated_)
+    if (allocated_ || shared_)
     {
-      free(common.data);
+      if (allocated_)
+        free(common.data);
+      shared_.reset();
       common.data = 0;
       common.size = 0;
     }
   }
 
+  void
+  UBinary::share()
+  {
+    if (shared_ || !common.data)
+      return;
+    if (!allocated_)
+    {
+      // Not ours: the user may reclaim it.
+      void* data = malloc(common.size);
+      memcpy(data, common.data, common.size);
+      common.data = data;
+    }
+    shared_.reset(common.data, free);
+    allocated_ = false;
+  }
+
+  void
+  UBinary::unshare()
+  {
+    if (!shared())
+      return;
+    void* data = malloc(common.size);
+    memcpy(data, common.data, common.size);
+    common.data = data;
+    shared_.reset();
+    allocated_ = true;
+  }
+
   UBinary::~UBinary()
   {
     clear();
@@ -107,8 +138,13 @@ namespace urbi
       sound = b.sound;
       message = b.message;
       type = b.type;
+      shared_ = b.shared_;
+      // A shared payload is freed by its owner only.
+      allocated_ = b.allocated_ && !b.shared_;
       UBinary& bb = const_cast<UBinary&>(b);
       bb.common.data = 0;
+      bb.shared_.reset();
+      bb.allocated_ = false;
       bb.type = BINARY_NONE;
       temporary_ = true;
       return *this;
@@ -128,8 +164,10 @@ namespace urbi
       case BINARY_UNKNOWN:
 	break;
     }
+    // Even if b's payload is shared: a deep copy may be modified.
     common.data = malloc(common.size);
     memcpy(common.data, b.common.data, b.common.size);
+    allocated_ = true;
     return *this;
   }
 
@@ -224,7 +262,13 @@ namespace urbi
 
     // Get the headers.
     message = headers_get(is);
+    decodeMessage();
+    return true;
+  }
 
+  void
+  UBinary::decodeMessage()
+  {
     // Analyse the header to decode know UBinary types.
     // Header stream.
     std::istringstream hs(message);
@@ -257,8 +301,6 @@ namespace urbi
       // GD_FWARN("unknown binary type: %s", t);
       type = BINARY_UNKNOWN;
     }
-
-    return true;
   }
 
   void UBinary::buildMessage()
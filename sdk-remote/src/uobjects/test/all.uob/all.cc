@@ -110,6 +110,7 @@ public:
                    setBypassNotifyChangeBinary, setBypassNotifyChangeImage);
     UBindFunctions(all, markBypass, markRTP);
     UBindFunctions(all, selfWriteB, selfWriteI, selfWriteVD);
+    UBindFunctions(all, copyTemporaryShared, shareBinary);
 
     UBindFunctions
       (all,
@@ -401,6 +402,54 @@ public:
     return res;
   }
 
+  // Copy a temporary binary whose payload is shared, as UValue::set
+  // does for the values written from worker threads.
+  std::string copyTemporaryShared(const std::string& content)
+  {
+    threadCheck();
+    urbi::UBinary b;
+    b.type = urbi::BINARY_UNKNOWN;
+    b.common.data = memdup(content);
+    b.common.size = content.size();
+    b.share();
+    urbi::UBinary keep(b, false);
+    b.temporary_ = true;
+    urbi::UBinary* c = new urbi::UBinary(b, true);
+    std::string res((char*)c->common.data, c->common.size);
+    delete c;
+    // The payload is still owned by the remaining copy.
+    res += std::string((char*)keep.common.data, keep.common.size);
+    return res;
+  }
+
+  // Write a binary to the UVar \a name, and read it twice: shallow
+  // copies share the stored payload, deep copies do not, and writing
+  // after unshare() leaves the UVar unchanged.
+  std::string shareBinary(const std::string& name, const std::string& content)
+  {
+    threadCheck();
+    urbi::UVar v(name);
+    urbi::UBinary b;
+    b.type = urbi::BINARY_UNKNOWN;
+    b.common.data = memdup(content);
+    b.common.size = content.size();
+    v = b;
+    const urbi::UBinary& first = v;
+    urbi::UBinary r1(first, false);
+    const urbi::UBinary& second = v;
+    urbi::UBinary r2(second, false);
+    urbi::UBinary deep(second);
+    std::string res =
+      r1.shared() && r1.common.data == r2.common.data ? "shared" : "copied";
+    res += deep.common.data == r2.common.data ? " aliased" : " deep";
+    r2.unshare();
+    static_cast<char*>(r2.common.data)[0] = 'X';
+    const urbi::UBinary& stored = v;
+    res += " " + std::string((char*)stored.common.data, stored.common.size);
+    res += " " + std::string((char*)r2.common.data, r2.common.size);
+    return res;
+  }
+
   std::string selfWriteI(int idx, const std::string& content)
   {
     threadCheck();
@@ -8,6 +8,7 @@
 
 bin_PROGRAMS +=					\
   utils/urbi-cycle				\
+  utils/urbi-image-bench			\
   utils/urbi-reverse				\
   utils/urbi-scale
 
@@ -0,0 +1,127 @@
+/*
+ * Copyright (C) 2012, Gostai S.A.S.
+ *
+ * This software is provided "as is" without warranty of any kind,
+ * either expressed or implied, including but not limited to the
+ * implied warranties of fitness for a particular purpose.
+ *
+ * See the LICENSE file for more information.
+ */
+
+#include <algorithm>
+
+#include <libport/cstdlib>
+#include <libport/cstdio>
+#include <libport/utime.hh>
+
+#include <urbi/uconversion.hh>
+
+using urbi::byte;
+
+void
+usage(const char* name, int status)
+{
+  printf("usage %s [width height [iterations]]\n"
+         "\tmeasure the speed of the image conversions on a synthetic\n"
+         "\tRGB image (1920x1080 by default), in MPixel/s\n", name);
+  if (status)
+    exit(status);
+}
+
+static void
+report(const char* name, size_t pixels, int iterations,
+       libport::utime_t start)
+{
+  libport::utime_t t = std::max(libport::utime() - start,
+                                libport::utime_t(1));
+  // Pixels per microsecond are MPixel per second.
+  printf("%-24s %8.1f MPixel/s\n", name,
+         double(pixels) * iterations / t);
+}
+
+static void
+bench_scale(const char* name, const urbi::UImage& src,
+            size_t w, size_t h, int iterations)
+{
+  libport::utime_t start = libport::utime();
+  for (int i = 0; i < iterations; ++i)
+  {
+    urbi::UImage dst;
+    dst.imageFormat = urbi::IMAGE_RGB;
+    dst.width = w;
+    dst.height = h;
+    urbi::convert(src, dst);
+    free(dst.data);
+  }
+  // Count the destination pixels, as the scalers do.
+  report(name, w * h, iterations, start);
+}
+
+int
+main(int argc, char* argv[])
+{
+  if (argc == 2 || 4 < argc)
+    usage(argv[0], 1);
+  size_t w = 1920;
+  size_t h = 1080;
+  int iterations = 20;
+  if (3 <= argc)
+  {
+    w = strtol(argv[1], 0, 0);
+    h = strtol(argv[2], 0, 0);
+  }
+  if (argc == 4)
+    iterations = strtol(argv[3], 0, 0);
+  if (!w || !h || iterations <= 0)
+    usage(argv[0], 1);
+
+  size_t pixels = w * h;
+  size_t size = pixels * 3;
+  byte* rgb = static_cast<byte*>(malloc(size));
+  byte* out = static_cast<byte*>(malloc(size));
+  for (size_t i = 0; i < size; ++i)
+    rgb[i] = (i * 7 + i / 3 / w * 13) & 255;
+
+  libport::utime_t start = libport::utime();
+  for (int i = 0; i < iterations; ++i)
+    urbi::convertRGBtoYCbCr(rgb, size, out);
+  report("RGB -> YCbCr", pixels, iterations, start);
+
+  start = libport::utime();
+  for (int i = 0; i < iterations; ++i)
+    urbi::convertYCbCrtoRGB(rgb, size, out);
+  report("YCbCr -> RGB", pixels, iterations, start);
+
+  start = libport::utime();
+  for (int i = 0; i < iterations; ++i)
+    urbi::convertRGBtoGrey8_601(rgb, size, out);
+  report("RGB -> grey8", pixels, iterations, start);
+
+  urbi::UImage src;
+  src.imageFormat = urbi::IMAGE_RGB;
+  src.width = w;
+  src.height = h;
+  src.size = size;
+  src.data = rgb;
+  bench_scale("scale x2 (bilinear)", src, w * 2, h * 2, iterations);
+  bench_scale("scale x0.75 (bilinear)", src, w * 3 / 4, h * 3 / 4,
+              iterations);
+  bench_scale("scale x0.5 (area)", src, w / 2, h / 2, iterations);
+  bench_scale("scale x0.25 (area)", src, w / 4, h / 4, iterations);
+
+  // Decoding, at full size and through the DCT scaling.
+  urbi::UImage jpeg;
+  jpeg.imageFormat = urbi::IMAGE_JPEG;
+  jpeg.width = w;
+  jpeg.height = h;
+  jpeg.size = size;
+  jpeg.data = static_cast<byte*>(malloc(size));
+  urbi::convertRGBtoJPEG(rgb, w, h, jpeg.data, jpeg.size, 80);
+  bench_scale("JPEG decode", jpeg, w, h, iterations);
+  bench_scale("JPEG decode x0.25", jpeg, w / 4, h / 4, iterations);
+  free(jpeg.data);
+
+  free(rgb);
+  free(out);
+  return 0;
+}
@@ -457,7 +457,10 @@ namespace eval
       * So fallback in case of implicit target is a bit costly, but that should
       * be rare.
       */
-      loc = tgt->slot_locate(s, false);
+      // The name is dynamic in update mode, the inline cache is useless.
+      loc = updateMode
+        ? tgt->slot_locate(s, false)
+        : tgt->slot_locate(s, false, e->lookup_cache_get());
       if (!loc.first) // Try import stacks, throw if not found
         loc = import_stack_lookup(this_.state, s, tgt, false);
       if (!loc.first) // Try this, with fallback
@@ -490,7 +493,7 @@ namespace eval
           }
         }
         return call_msg(this_, tgt, val, s, e->arguments_get(),
-        e->location_get());
+        e->location_get(), e);
       }
     }
     else
@@ -498,7 +501,9 @@ namespace eval
       return call_msg(this_,
         tgt, e->name_get(),
         e->arguments_get(),
-        e->location_get());
+        e->location_get(),
+        &e->lookup_cache_get(),
+        e);
     }
   }
 
@@ -595,7 +600,15 @@ namespace eval
   LIBPORT_SPEED_ALWAYS_INLINE rObject
   Visitor::visit(const ast::Float* e)
   {
-    return new object::Float(e->value_get());
+    // Hand out the Float of the previous evaluation again if nobody
+    // else holds it anymore and it was not modified: it cannot be told
+    // apart from a fresh one, and it saves an allocation in loops.
+    rObject& res = e->value_cache_get();
+    if (!res
+        || res->counter_get() != 1
+        || !res->bare_instance_of(object::Float::proto))
+      res = new object::Float(e->value_get());
+    return res;
   }
 
   LIBPORT_SPEED_ALWAYS_INLINE
@@ -647,9 +660,9 @@ namespace eval
   Visitor::visit(const ast::If* e)
   {
     if (ast(this_, e->test_get().get())->as_bool())
-      return ast(this_, e->thenclause_get());
+      return ast(this_, e->thenclause_get().get());
     else
-      return ast(this_, e->elseclause_get());
+      return ast(this_, e->elseclause_get().get());
 
     /*
       e->test_get().get()->visit(*this);
@@ -30,8 +30,10 @@ namespace eval
   INLINE_AST_FUNCS
   rObject ast_context(Job& job, const ast::Ast* e, rObject self);
 
+  /// Evaluate \a ast.  It is up to the caller to keep it alive: this
+  /// spares the reference counting of every node evaluated.
   INLINE_AST_FUNCS
-  rObject ast(Job& job, ast::rConstAst ast);
+  rObject ast(Job& job, const ast::Ast* ast);
 
   INLINE_AST_FUNCS
   Action  ast(ast::rConstAst ast);
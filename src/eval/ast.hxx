@@ -55,7 +55,7 @@ namespace eval
   // !!! GD_* macros are commented because this consume stack space in speed
   // mode, even if messages are not printed.
 
-  rObject ast(Job& job, ast::rConstAst n)
+  rObject ast(Job& job, const ast::Ast* n)
   {
     // GD_CATEGORY(Urbi.Eval.Ast);
 
@@ -64,15 +64,22 @@ namespace eval
     //                string_cast(n->location_get()));
     const ast::Ast* previous = job.state.innermost_node_get();
     FINALLY_Ast(USE);
-    job.state.innermost_node_set(n.get());
+    job.state.innermost_node_set(n);
 
     // let the AST node bounce on the ast_impl::eval functions
     return n->eval(job);
   }
 
+  /// Evaluate \a n, holding it.
+  inline
+  rObject ast_held(Job& job, ast::rConstAst n)
+  {
+    return ast(job, n.get());
+  }
+
   Action ast(ast::rConstAst n)
   {
-    return boost::bind(&ast, _1, n);
+    return boost::bind(&ast_held, _1, n);
   }
 
 } // namespace eval
@@ -114,18 +114,24 @@ namespace eval
   | Apply with arguments as ast chunks.  |
   `-------------------------------------*/
 
+  /// If \a cache is given, use it to look \a message up.  If \a site
+  /// is given, it holds the \a arguments, and caches their lazy
+  /// version.
   rObject call_msg(Job& job,
                    rObject target,
                    libport::Symbol message,
                    const ::ast::exps_type* arguments,
-                   boost::optional< ::ast::loc> loc);
+                   boost::optional< ::ast::loc> loc,
+                   object::LookupCache* cache = 0,
+                   const ::ast::Call* site = 0);
 
   rObject call_msg(Job& job,
                    object::Object* target,
                    object::Object* routine,
                    libport::Symbol message,
                    const ::ast::exps_type* input_ast_args,
-                   boost::optional< ::ast::loc> loc);
+                   boost::optional< ::ast::loc> loc,
+                   const ::ast::Call* site = 0);
 
   void
   strict_args(Job& job,
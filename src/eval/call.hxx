@@ -21,6 +21,7 @@
 #include <libport/compilation.hh>
 #include <libport/range.hh>
 
+#include <ast/call.hh>
 #include <ast/exps-type.hh>
 #include <ast/local-declarations-type.hh>
 #include <ast/factory.hh>
@@ -91,7 +92,8 @@ namespace eval
                      object::Object* tgt,
                      object::Object* code,
                      libport::Symbol msg,
-                     const ::ast::exps_type& args);
+                     const ::ast::exps_type& args,
+                     const ::ast::Call* site);
 
 
 
@@ -474,7 +476,7 @@ namespace eval
             // Validate type if specified
             if (formal->type_get())
             {
-              rObject oType = eval::ast(job, formal->type_get());
+              rObject oType = eval::ast(job, formal->type_get().get());
               rObject res = (*effective)->call(SYMBOL(isA), oType);
               if (!res->as_bool())
               {
@@ -491,11 +493,10 @@ namespace eval
           else
           {
             // Take default value.
-            // FIXME: !!! remove this cast.
             if (formal->value_get())
               job.state.def_arg(
                 formal,
-                eval::ast(job, ::ast::rConstAst(formal->value_get().get())));
+                eval::ast(job, formal->value_get().get()));
             else
                 job.state.def_arg(
                 formal,
@@ -532,14 +533,17 @@ namespace eval
                    rObject target,
                    libport::Symbol message,
                    const ::ast::exps_type* arguments,
-                   boost::optional< ::ast::loc> location)
+                   boost::optional< ::ast::loc> location,
+                   object::LookupCache* cache,
+                   const ::ast::Call* site)
   {
     // Accept to call methods on void only if void itself is holding
     // the method.
     if (target == object::void_class
         && !target->local_slot_get(message))
       runner::raise_unexpected_void_error();
-    rObject routine = target->slot_get(message);
+    rObject routine =
+      cache ? target->slot_get(message, *cache) : target->slot_get(message);
     static ::ast::exps_type*  empty_args = new ::ast::exps_type();
     if (rSlot s = routine->as<Slot>())
     {
@@ -556,7 +560,7 @@ namespace eval
                     target,
                     routine,
                     message,
-                    arguments, location);
+                    arguments, location, site);
   }
 
   LIBPORT_SPEED_INLINE
@@ -565,7 +569,8 @@ namespace eval
                    object::Object* routine,
                    libport::Symbol message,
                    const ::ast::exps_type* input_ast_args,
-                   boost::optional< ::ast::loc> loc)
+                   boost::optional< ::ast::loc> loc,
+                   const ::ast::Call* site)
   {
     aver(routine);
     aver(target);
@@ -586,8 +591,7 @@ namespace eval
     // target.
     object::objects_type args;
     args << target;
-    ::ast::exps_type ast_args =
-      input_ast_args ? *input_ast_args : ::ast::exps_type();
+    const ::ast::exps_type& ast_args = *input_ast_args;
 
     rObject call_message;
 
@@ -596,7 +600,7 @@ namespace eval
     // Build a call message if the function uses it.
     if (c && c->ast_get()->uses_call_get())
       call_message =
-        build_call_message(job, target, routine, message, ast_args);
+        build_call_message(job, target, routine, message, ast_args, site);
 
     // Unless the function is lazy, evaluate the arguments.
     if (!c || c->ast_get()->strict())
@@ -677,13 +681,19 @@ namespace eval
   {
   public:
     typedef ::ast::Transformer super_type;
+    typedef ::ast::Call::LazyArg::Capture Capture;
+
+    /// If \a captures is given, record there where the captured
+    /// variables are in the current frame.
     Rebinder(::ast::rRoutine routine,
              object::rCode code,
-             runner::State& state)
+             runner::State& state,
+             std::vector<Capture>* captures = 0)
       : idx_(0)
       , routine_(routine)
       , code_(code)
       , state_(state)
+      , captures_(captures)
     {}
 
   protected:
@@ -731,6 +741,8 @@ namespace eval
 
       object::rSlot value = state_.rget_assignment(assignment);
       code_->captures_get() << value;
+      capture_(assignment->what_get(), assignment->local_index_get(),
+               assignment->depth_get());
 
       // Capture the variable
       assignment->depth_set(assignment->depth_get() + 1);
@@ -760,6 +772,8 @@ namespace eval
       // Retreive the value to capture.
       object::rSlot value = state_.rget(local);
       code_->captures_get() << value;
+      capture_(local->name_get(), local->local_index_get(),
+               local->depth_get());
 
       // Capture the variable
       local->depth_set(local->depth_get() + 1);
@@ -774,11 +788,22 @@ namespace eval
     }
 
   private:
+    void
+    capture_(libport::Symbol name, unsigned index, unsigned depth)
+    {
+      if (captures_)
+      {
+        Capture c = { name, index, depth };
+        *captures_ << c;
+      }
+    }
+
     unsigned idx_;
     std::set< ::ast::LocalDeclaration*> decls_;
     ::ast::rRoutine routine_;
     object::rCode code_;
     runner::State& state_;
+    std::vector<Capture>* captures_;
   };
 
   LIBPORT_SPEED_INLINE
@@ -787,7 +812,8 @@ namespace eval
                      object::Object* tgt,
                      object::Object* code,
                      libport::Symbol msg,
-                     const ::ast::exps_type& args)
+                     const ::ast::exps_type& args,
+                     const ::ast::Call* site)
   {
     DECLARE_LOCATION_FILE;
     // Prepare current imports, to be stored in closure around args
@@ -796,33 +822,61 @@ namespace eval
       imports = job.state.import_stack.back();
     imports.insert(imports.end(),
       job.state.import_captured.begin(), job.state.import_captured.end());
+    // The routines wrapping the arguments depend only on the AST: the
+    // call site keeps them, and each call only closes them over the
+    // current frame.
+    ::ast::Call::lazy_args_type built;
+    ::ast::Call::lazy_args_type* cached = site ? &site->lazy_args_get() : 0;
+    if (cached && cached->size() != args.size())
+      cached = 0;
     // Build the list of lazy arguments
     object::objects_type lazy_args;
     lazy_args << tgt;
-    foreach (const ::ast::rConstExp& e, args)
+    for (unsigned i = 0; i < args.size(); ++i)
     {
-      // Create the lazy version of arguments.
-      ::ast::rExp body = //const_cast< ::ast::Exp*>(e.get());
-        ::ast::new_clone(e);
-
-      ::ast::rRoutine routine =
-        new ::ast::Routine(LOCATION_HERE,
-                         true, new ::ast::local_declarations_type,
-                         ::ast::Factory::make_scope(LOCATION_HERE, body));
-
-      rCode closure =
-        // FIXME: something fishy about the lobby here.
-        new Code(routine.get(),
-                 job.state.call(),
-                 job.state.lobby_get(),
-                 job.state.this_get());
+      rCode closure;
+      if (cached)
+      {
+        const ::ast::Call::LazyArg& arg = (*cached)[i];
+        closure = new Code(arg.routine.get(),
+                           job.state.call(),
+                           job.state.lobby_get(),
+                           job.state.this_get());
+        foreach (const ::ast::Call::LazyArg::Capture& c, arg.captures)
+          closure->captures_get() << job.state.rget(c.name, c.index, c.depth);
+      }
+      else
+      {
+        // Create the lazy version of arguments.
+        ::ast::rExp body = ::ast::new_clone(args[i]);
+
+        ::ast::rRoutine routine =
+          new ::ast::Routine(LOCATION_HERE,
+                             true, new ::ast::local_declarations_type,
+                             ::ast::Factory::make_scope(LOCATION_HERE, body));
+
+        closure =
+          // FIXME: something fishy about the lobby here.
+          new Code(routine.get(),
+                   job.state.call(),
+                   job.state.lobby_get(),
+                   job.state.this_get());
+        ::ast::Call::LazyArg arg;
+        arg.routine = routine;
+        Rebinder rebind(routine, closure, job.state,
+                        site ? &arg.captures : 0);
+        rebind(body.get());
+        if (site)
+          built << arg;
+      }
       closure->imports_get() = imports;
-      Rebinder rebind(routine, closure, job.state);
-      rebind(body.get());
 
       CAPTURE_GLOBAL(Lazy);
       lazy_args << Lazy->call("new", closure);
     }
+    // Publish the routines only once they are all complete.
+    if (site && !cached)
+      std::swap(site->lazy_args_get(), built);
 
     return build_call_message(job, code, msg, lazy_args);
   }
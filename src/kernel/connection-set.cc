@@ -33,7 +33,13 @@ namespace kernel
   void
   ConnectionSet::add(UConnection* c)
   {
-    connections_.push_front(c);
+    connections_.insert(c);
+  }
+
+  void
+  ConnectionSet::remove(UConnection* c)
+  {
+    connections_.erase(c);
   }
 
   void
@@ -11,20 +11,24 @@
 #ifndef KERNEL_CONNECTION_SET_HH
 # define KERNEL_CONNECTION_SET_HH
 
-# include <boost/ptr_container/ptr_list.hpp>
+# include <boost/unordered_set.hpp>
 
 # include <urbi/kernel/uconnection.hh>
 
 namespace kernel
 {
+  /// The connections of the server.  Hashed, so that servers with
+  /// thousands of clients do not pay a linear scan per disconnection.
   class ConnectionSet
   {
   public:
     void add(UConnection* c);
 
+    void remove(UConnection* c);
+
     void clear();
 
-    typedef std::list<UConnection*> connections_type;
+    typedef boost::unordered_set<UConnection*> connections_type;
 
     /// Present an iterable interface for sake of foreach.
     typedef connections_type::iterator iterator;
@@ -34,7 +38,6 @@ namespace kernel
 
   private:
     connections_type connections_;
-    friend class UServer;
   };
 }
 
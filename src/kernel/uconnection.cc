@@ -57,6 +57,8 @@ namespace kernel
     , send_queue_(new queue_type(1024))
     , packet_size_(packetSize)
     , blocked_(false)
+    , stamp_time_(-1)
+    , stamp_size_(0)
       // Initial state of the connection: unblocked, not receiving binary.
     , active_(true)
     , interactive_p_(true)
@@ -95,12 +97,21 @@ namespace kernel
   {
     if (tag)
     {
+      // Many messages are sent per cycle: render the time stamp once.
+      libport::utime_t time = server_.lastTime() / 1000L;
+      if (time != stamp_time_)
+      {
+        stamp_time_ = time;
+        stamp_size_ = snprintf(stamp_, sizeof stamp_,
+                               "[%08lld", static_cast<long long>(time));
+      }
+      send_queue(stamp_, stamp_size_);
       if (*tag)
-        send_queue(libport::format("[%08d:%s] ",
-                                   server_.lastTime() / 1000L, tag));
-      else
-        send_queue(libport::format("[%08d] ",
-                                   server_.lastTime() / 1000L));
+      {
+        send_queue(":", 1);
+        send_queue(tag, strlen(tag));
+      }
+      send_queue("] ", 2);
     }
     if (buf)
     {
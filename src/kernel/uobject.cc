@@ -10,10 +10,13 @@
 
 #include <cstdarg>
 
+#include <boost/unordered_map.hpp>
+
 #include <libport/bind.hh>
 #include <libport/lexical-cast.hh>
 #include <libport/foreach.hh>
 #include <libport/hash.hh>
+#include <libport/pthread.h>
 #include <libport/lexical-cast.hh>
 #include <libport/synchronizer.hh>
 
@@ -31,6 +34,7 @@
 #include <urbi/object/event.hh>
 #include <urbi/object/float.hh>
 #include <urbi/object/global.hh>
+#include <urbi/object/list.hh>
 #include <urbi/object/lobby.hh>
 #include <urbi/object/object.hh>
 #include <urbi/object/slot.hh>
@@ -293,6 +297,27 @@ namespace urbi
       std::pair<std::string, std::string> splitName_;
       ATTRIBUTE_RW(object::rSlot, slot);
       friend class KernelUGenericCallbackImpl;
+
+      /* Reads from other threads are served from a copy of the value,
+       * taken by the main thread when a thread reads the UVar, and
+       * dropped as soon as the slot, or the list it holds, changes.
+       * Only plain values are copied: getters must run, and other
+       * objects may change without notice.
+       */
+      void snapshot_take();
+      void snapshot_invalidate(const object::objects_type&);
+      void snapshot_forget();
+      /// The copy, and whether it is usable.  Protected by asyncLock_.
+      UValue snapshot_;
+      bool snapshot_valid_;
+      /// Subscriptions to the slot's changed, and the list's
+      /// contentChanged.  Main thread only.
+      object::rSubscription snapshot_changed_;
+      object::rSubscription snapshot_content_;
+      /// The copy given to each reading thread, valid until its next
+      /// read.  Protected by asyncLock_, dropped by clean().
+      typedef boost::unordered_map<pthread_t, UValue> copies_type;
+      mutable copies_type copies_;
     };
 
     class KernelUGenericCallbackImpl: public UGenericCallbackImpl
@@ -631,6 +656,33 @@ static void write_and_unfreeze_mainthread(object::rTag* tag,
   }
 }
 
+/* Results of the threaded calls, written back in a single fast async
+ * job, instead of one each.
+ */
+static libport::Lockable threaded_results_lock;
+static std::vector<boost::function0<void> > threaded_results;
+
+static void threaded_results_write()
+{
+  std::vector<boost::function0<void> > results;
+  {
+    libport::BlockLock bl(threaded_results_lock);
+    std::swap(results, threaded_results);
+  }
+  foreach (const boost::function0<void>& f, results)
+  {
+    // Do not lose the remaining results.
+    try
+    {
+      f();
+    }
+    catch (const std::exception& e)
+    {
+      GD_FWARN("Exception writing a threaded result: %s", e.what());
+    }
+  }
+}
+
 static void write_and_unfreeze(urbi::UValue& r, std::string& exception,
                                bool* async_abort,
                                object::rTag* tag,
@@ -641,11 +693,20 @@ static void write_and_unfreeze(urbi::UValue& r, std::string& exception,
   if (e)
     exceptionMessage = e->what();
   if (server().isAnotherThread())
-    server().schedule_fast(
-                      boost::bind(&write_and_unfreeze_mainthread, tag,
-                                  boost::ref(r), boost::ref(exception),
-                                  async_abort, new urbi::UValue(v),
-                                  exceptionMessage));
+  {
+    bool empty;
+    {
+      libport::BlockLock bl(threaded_results_lock);
+      empty = threaded_results.empty();
+      threaded_results.push_back(
+        boost::bind(&write_and_unfreeze_mainthread, tag,
+                    boost::ref(r), boost::ref(exception),
+                    async_abort, new urbi::UValue(v),
+                    exceptionMessage));
+    }
+    if (empty)
+      server().schedule_fast(&threaded_results_write);
+  }
   else
   {
     exception = exceptionMessage;
@@ -1602,7 +1663,71 @@ namespace urbi
     KernelUVarImpl::KernelUVarImpl()
       : pending_(0)
       , bypassMode_(false)
+      , snapshot_valid_(false)
+    {
+    }
+
+    void
+    KernelUVarImpl::snapshot_take()
+    {
+      snapshot_forget();
+      // The input of owned UVars is not notified.
+      if (!slot_ || slot_->get_get() || slot_->oget_get()
+          || (owner_->owned && slot_->split_get()))
+        return;
+      rObject o = (owner_->owned || !slot_->split_get()
+                   ? slot_->value_get()
+                   : slot_->output_value_get());
+      UValue v;
+      if (object::rUValue bv = o->as<object::UValue>())
+      {
+        // Bypass values are only valid during their notifies.
+        if (bv->bypassMode_get())
+          return;
+        v = bv->value_get();
+      }
+      else if (o->as<object::Float>() || o->as<object::String>())
+        v = ::uvalue_cast(o);
+      else if (object::rList l = o->as<object::List>())
+      {
+        foreach (const rObject& e, l->value_get())
+          if (!e->as<object::Float>() && !e->as<object::String>())
+            return;
+        v = ::uvalue_cast(o);
+        snapshot_content_ = l->contentChanged_get()->onEvent(
+          boost::bind(&KernelUVarImpl::snapshot_invalidate, this, _1));
+      }
+      else
+        return;
+      snapshot_changed_ = slot_->changed()->as<object::Event>()
+        ->onEvent(boost::bind(&KernelUVarImpl::snapshot_invalidate, this, _1));
+      libport::BlockLock bl(asyncLock_);
+      snapshot_ = v;
+      snapshot_valid_ = true;
+    }
+
+    void
+    KernelUVarImpl::snapshot_invalidate(const object::objects_type&)
     {
+      // Called by the subscription itself, which must not be stopped
+      // here: the next snapshot_take does it.
+      libport::BlockLock bl(asyncLock_);
+      snapshot_valid_ = false;
+    }
+
+    void
+    KernelUVarImpl::snapshot_forget()
+    {
+      {
+        libport::BlockLock bl(asyncLock_);
+        snapshot_valid_ = false;
+      }
+      if (snapshot_changed_)
+        snapshot_changed_->stop();
+      if (snapshot_content_)
+        snapshot_content_->stop();
+      snapshot_changed_ = 0;
+      snapshot_content_ = 0;
     }
 
     void
@@ -1687,7 +1812,14 @@ namespace urbi
       else
         while(pending_)
           ::kernel::runner().yield();
-      //noop
+      // The subscriptions are only read by the main thread.
+      if (server().isAnotherThread())
+        schedule(SYMBOL(UObject),
+                 boost::bind(&KernelUVarImpl::snapshot_forget, this), true);
+      else
+        snapshot_forget();
+      libport::BlockLock bl(asyncLock_);
+      copies_.clear();
     }
 
     void KernelUVarImpl::setOwned()
@@ -1726,6 +1858,12 @@ namespace urbi
         UValue vv(v);
         if (vv.type == DATA_BINARY)
           vv.binary->temporary_ = true;
+        {
+          // The next read waits for this write, and gets the value as
+          // stored by the slot (after its setters and ranges).
+          libport::BlockLock bl(asyncLock_);
+          snapshot_valid_ = false;
+        }
         schedule(SYMBOL(UObject), boost::bind(&KernelUVarImpl::set, this, vv));
         return;
       }
@@ -1748,12 +1886,24 @@ namespace urbi
     void KernelUVarImpl::async_get(UValue** v) const
     {
       *v = &const_cast<UValue&>(get());
+      const_cast<KernelUVarImpl*>(this)->snapshot_take();
     }
 
     const UValue& KernelUVarImpl::get() const
     {
       if (server().isAnotherThread())
       {
+        // Each thread gets its own copy of the snapshot, valid until its
+        // next read of this UVar.
+        {
+          libport::BlockLock bl(asyncLock_);
+          if (snapshot_valid_)
+          {
+            UValue& res = copies_[pthread_self()];
+            res = snapshot_;
+            return res;
+          }
+        }
         urbi::UValue* v;
         schedule(SYMBOL(UObject),
                  boost::bind(&KernelUVarImpl::async_get, this, &v),
@@ -2130,6 +2280,19 @@ namespace urbi
       return res;
     }
 
+    /// The binary frame holding the message list \a msg.
+    static rObject
+    serialize_message(rObject msg)
+    {
+      std::ostringstream o;
+      libport::serialize::BinaryOSerializer ser(o);
+      ser << ::uvalue_cast(msg);
+      CAPTURE_GLOBAL(Binary);
+      return Binary->call(SYMBOL(new),
+                          object::to_urbi(urbi::externalFrameKeyword),
+                          object::to_urbi(o.str()));
+    }
+
     /*! Initialize plugin UObjects.
       \param args object in which the instances will be stored.
     */
@@ -2150,6 +2313,8 @@ namespace urbi
                             object::primitive(&all_uobjects));
       where->slot_set_value(SYMBOL(findUObject),
                             object::primitive(&get_robject));
+      where->slot_set_value(SYMBOL(serializeMessage),
+                            object::primitive(&serialize_message));
       Object->slot_set_value(SYMBOL(uvalueDeserialize), primitive(&uvalue_deserialize));
 
       where->bind(SYMBOL(searchPath),    &uobject_uobjectsPath,
@@ -2302,6 +2467,18 @@ namespace urbi
                  object_cast(val));
       }
       break;
+      case urbi::UEM_REPLYERROR:
+      {
+        std::string id;
+        std::string message;
+        ia >> id >> message;
+        CAPTURE_GLOBAL(Exception);
+        CAPTURE_GLOBAL(UObject);
+        UObject->call(SYMBOL(funCall), object::to_urbi(id),
+                      Exception->call(SYMBOL(new),
+                                      object::to_urbi(message)));
+      }
+      break;
       case urbi::UEM_EVAL:
       {
         std::string code;
@@ -72,6 +72,7 @@
 
 #include <runner/state.hh>
 #include <runner/job.hh>
+#include <runner/scheduler-stats.hh>
 #include <runner/shell.hh>
 #include <runner/sneaker.hh>
 
@@ -530,15 +531,17 @@ namespace kernel
     // To make sure that we get different times before and after every work
     // phase if we use a monotonic clock, update the time before and after
     // working.
-    libport::utime_t next_time;
+    updateTime();
+    libport::utime_t ctime = libport::utime();
+    runner::SchedulerStats::cycle_begin(ctime);
+    libport::utime_t next_time = scheduler_->work ();
+    libport::utime_t rtime = next_time? std::max(0LL, next_time - ctime):0;
+    libport::utime_t end = libport::utime();
+    runner::SchedulerStats::cycle_end(end);
+    ctime = end - ctime;
+    updateTime();
     if (report)
     {
-      updateTime();
-      libport::utime_t ctime = libport::utime();
-      next_time = scheduler_->work ();
-      libport::utime_t rtime = next_time? std::max(0LL, next_time - ctime):0;
-      ctime = libport::utime() - ctime;
-      updateTime();
       if (!rtime)
         nzero++;
       else
@@ -573,12 +576,6 @@ namespace kernel
         nzero = 0;
       }
     }
-    else
-    {
-      updateTime();
-      next_time = scheduler_->work ();
-      updateTime();
-    }
     if (!async_jobs_.empty())
       async_jobs_process_();
     work_handle_stopall_();
@@ -807,7 +804,7 @@ namespace kernel
   void
   UServer::connection_remove(UConnection& connection)
   {
+    connections_->remove(&connection);
     delete &connection;
-    connections_->connections_.remove(&connection);
   }
 }
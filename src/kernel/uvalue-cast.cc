@@ -8,6 +8,9 @@
  * See the LICENSE file for more information.
  */
 
+#include <boost/algorithm/string/trim.hpp>
+
+#include <libport/cstring>
 #include <libport/format.hh>
 #include <libport/lexical-cast.hh>
 
@@ -108,18 +111,17 @@ urbi::UValue uvalue_cast(const object::rObject& o, int recursionLevel)
   {
     const std::string& data =
       o->slot_get_value(SYMBOL(data))->as<object::String>()->value_get();
-    std::string keywords =
+    const std::string& keywords =
       o->slot_get_value(SYMBOL(keywords))->as<object::String>()->value_get();
-    std::list<urbi::BinaryData> l;
-    l << urbi::BinaryData(const_cast<char*>(data.c_str()), data.size());
-    std::list<urbi::BinaryData>::const_iterator i = l.begin();
+    // Decode the headers directly, no need to print and parse them.
     res.type = urbi::DATA_BINARY;
     res.binary = new urbi::UBinary();
-    res.binary->parse(libport::format("%s%s%s\n",
-                                      data.size(),
-                                      keywords.empty() ? "" : " ",
-                                      keywords).c_str(),
-                      0, l, i);
+    res.binary->common.size = data.size();
+    res.binary->common.data = malloc(data.size());
+    memcpy(res.binary->common.data, data.c_str(), data.size());
+    res.binary->message = boost::algorithm::trim_copy(keywords);
+    res.binary->decodeMessage();
+    res.binary->share();
   }
   else if (is_a(o, UObject))
     res = o->slot_get_value(SYMBOL(__uobjectName))
@@ -0,0 +1,75 @@
+/*
+ * Copyright (C) 2012, Gostai S.A.S.
+ *
+ * This software is provided "as is" without warranty of any kind,
+ * either expressed or implied, including but not limited to the
+ * implied warranties of fitness for a particular purpose.
+ *
+ * See the LICENSE file for more information.
+ */
+
+/**
+ ** \file object/allocator.cc
+ ** \brief Implementation of object::SizeClassAllocator.
+ */
+
+#include <algorithm>
+
+#include <urbi/object/allocator.hh>
+
+namespace urbi
+{
+  namespace object
+  {
+    /*---------------------.
+    | SizeClassAllocator.  |
+    `---------------------*/
+
+    SizeClassAllocator::Chunk*
+    SizeClassAllocator::free_[max_size / granularity];
+
+    void
+    SizeClassAllocator::refill(size_t c)
+    {
+      size_t size = (c + 1) * granularity;
+      // Blocks of about 16KB, but at least 16 chunks.
+      size_t count = std::max(size_t(16), 16 * 1024 / size);
+      char* block = static_cast<char*>(::operator new(size * count));
+      for (size_t i = 0; i < count; ++i)
+      {
+        Chunk* chunk = reinterpret_cast<Chunk*>(block + i * size);
+        chunk->next = free_[c];
+        free_[c] = chunk;
+      }
+    }
+
+
+    /*------------------.
+    | AllocationStats.  |
+    `------------------*/
+
+    // The counters are not initialized here: instances are static, hence
+    // zero-initialized, and objects may be allocated by other static
+    // initializers before this constructor runs.
+    AllocationStats::AllocationStats(const std::string& n, size_t s)
+      : name(n)
+      , size(s)
+    {
+      instances().push_back(this);
+    }
+
+    AllocationStats::~AllocationStats()
+    {
+      instances_type& all = instances();
+      all.erase(std::remove(all.begin(), all.end(), this), all.end());
+    }
+
+    AllocationStats::instances_type&
+    AllocationStats::instances()
+    {
+      // Allocated dynamically to avoid static destruction order fiasco.
+      static instances_type* res = new instances_type;
+      return *res;
+    }
+  }
+}
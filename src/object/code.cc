@@ -13,6 +13,7 @@
  ** \brief Creation of the Urbi object code.
  */
 
+#include <libport/foreach.hh>
 #include <libport/lexical-cast.hh>
 
 #include <ast/parametric-ast.hh>
@@ -133,6 +134,35 @@ namespace urbi
       this_ = v;
     }
 
+    void
+    Code::references_get(references_type& res) const
+    {
+      super_type::references_get(res);
+      if (call_)
+        res.push_back(call_.get());
+      foreach (const rSlot& s, captures_)
+        if (s)
+          res.push_back(s.get());
+      if (lobby_)
+        res.push_back(lobby_.get());
+      if (this_)
+        res.push_back(this_.get());
+      foreach (const rObject& o, imports_)
+        if (o)
+          res.push_back(o.get());
+    }
+
+    void
+    Code::references_clear()
+    {
+      super_type::references_clear();
+      call_ = 0;
+      captures_.clear();
+      lobby_ = 0;
+      this_ = 0;
+      imports_.clear();
+    }
+
     rObject Code::apply(const objects_type& apply_args)
     {
       check_arg_count(apply_args.size(), 1, 2);
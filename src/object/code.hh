@@ -70,6 +70,9 @@ namespace urbi
 
       virtual std::ostream& special_slots_dump (std::ostream& o) const;
 
+      virtual void references_get(references_type& res) const;
+      virtual void references_clear();
+
       std::vector<rObject>& imports_get() { return imports_;}
       void import_add(rObject& v) { imports_.push_back(v); }
     private:
@@ -0,0 +1,224 @@
+/*
+ * Copyright (C) 2012, Gostai S.A.S.
+ *
+ * This software is provided "as is" without warranty of any kind,
+ * either expressed or implied, including but not limited to the
+ * implied warranties of fitness for a particular purpose.
+ *
+ * See the LICENSE file for more information.
+ */
+
+/**
+ ** \file object/cycle-collector.cc
+ ** \brief Implementation of object::CycleCollector.
+ */
+
+#include <algorithm>
+#include <cstdlib>
+
+#include <boost/unordered_map.hpp>
+
+#include <libport/containers.hh>
+#include <libport/debug.hh>
+#include <libport/foreach.hh>
+
+#include <object/cycle-collector.hh>
+#include <object/finalizable.hh>
+#include <urbi/object/lookup-cache.hh>
+#include <urbi/object/object.hh>
+
+GD_CATEGORY(Urbi.Object);
+
+namespace urbi
+{
+  namespace object
+  {
+    size_t CycleCollector::collections = 0;
+    size_t CycleCollector::scanned = 0;
+    size_t CycleCollector::reclaimed = 0;
+    libport::utime_t CycleCollector::pause_last = 0;
+    libport::utime_t CycleCollector::pause_max = 0;
+    libport::utime_t CycleCollector::pause_total = 0;
+
+    CycleCollector::candidates_type CycleCollector::candidates_;
+    size_t CycleCollector::cursor_ = 0;
+    libport::utime_t CycleCollector::budget_ =
+      getenv("URBI_CYCLE_COLLECTOR") ? atoi(getenv("URBI_CYCLE_COLLECTOR")) : 0;
+
+    void
+    CycleCollector::budget_set(libport::utime_t budget)
+    {
+      budget_ = budget;
+      if (!budget_)
+      {
+        foreach (Object* o, candidates_)
+          o->cycle_index_ = -1;
+        candidates_.clear();
+        cursor_ = 0;
+      }
+    }
+
+    void
+    CycleCollector::stats_reset()
+    {
+      collections = scanned = reclaimed = 0;
+      pause_last = pause_max = pause_total = 0;
+    }
+
+    void
+    CycleCollector::idle(libport::utime_t deadline)
+    {
+      if (candidates_.size() <= cursor_)
+        return;
+      libport::utime_t now = libport::utime();
+      if (deadline <= now)
+        return;
+      step(std::min(deadline, now + budget_));
+    }
+
+    size_t
+    CycleCollector::collect()
+    {
+      size_t res = 0;
+      cursor_ = 0;
+      while (cursor_ < candidates_.size())
+        res += step(0);
+      return res;
+    }
+
+    namespace
+    {
+      /// What a collection knows about an object.
+      struct Node
+      {
+        /// The trial reference count.
+        long count;
+        /// Whether the references of the object are considered.
+        bool expanded;
+        /// Whether the object is referred to from outside the subgraph.
+        bool black;
+      };
+      typedef boost::unordered_map<Object*, Node> nodes_type;
+
+      /// Whether a collection may consider the references of \a o.
+      bool
+      expandable(Object* o)
+      {
+        // Finalizable objects fiddle with their counts, and their
+        // finalizer may need their slots.
+        return o->counter_get() <= CycleCollector::opaque_count
+          && !dynamic_cast<Finalizable*>(o);
+      }
+    }
+
+    size_t
+    CycleCollector::step(libport::utime_t deadline)
+    {
+      libport::utime_t start = libport::utime();
+      nodes_type nodes;
+      Object::references_type refs;
+      std::vector<Object*> todo;
+      std::vector<Object*> roots;
+      // Whether some objects were not traversed for lack of room.
+      bool truncated = false;
+
+      // MarkGray: subtract the internal references, from as many roots
+      // as the budget permits.
+      while (cursor_ < candidates_.size() && nodes.size() < max_nodes)
+      {
+        if (deadline && deadline <= libport::utime())
+          break;
+        Object* root = candidates_[cursor_++];
+        roots.push_back(root);
+        if (libport::has(nodes, root))
+          continue;
+        Node n = { root->counter_get(), expandable(root), false };
+        nodes[root] = n;
+        todo.push_back(root);
+        while (!todo.empty())
+        {
+          Object* o = todo.back();
+          todo.pop_back();
+          if (!nodes[o].expanded)
+            continue;
+          refs.clear();
+          o->references_get(refs);
+          foreach (Object* r, refs)
+          {
+            nodes_type::iterator i = nodes.find(r);
+            if (i == nodes.end())
+            {
+              if (max_nodes <= nodes.size())
+                truncated = true;
+              Node n = { r->counter_get(),
+                         nodes.size() < max_nodes && expandable(r),
+                         false };
+              i = nodes.insert(std::make_pair(r, n)).first;
+              todo.push_back(r);
+            }
+            --i->second.count;
+          }
+        }
+      }
+
+      // Scan: blacken the objects referred to from outside, and all
+      // they reach.
+      foreach (nodes_type::value_type& n, nodes)
+        if (0 < n.second.count || !n.second.expanded)
+        {
+          n.second.black = true;
+          todo.push_back(n.first);
+        }
+      while (!todo.empty())
+      {
+        Object* o = todo.back();
+        todo.pop_back();
+        if (!nodes[o].expanded)
+          continue;
+        refs.clear();
+        o->references_get(refs);
+        foreach (Object* r, refs)
+        {
+          Node& n = nodes[r];
+          if (!n.black)
+          {
+            n.black = true;
+            todo.push_back(r);
+          }
+        }
+      }
+
+      // The roots referred to from outside are no longer candidates,
+      // unless the collection was partial.
+      if (!truncated)
+        foreach (Object* r, roots)
+          if (nodes[r].black)
+            forget(r);
+
+      // CollectWhite: hold the garbage while breaking its cycles, then
+      // let it go.
+      objects_type garbage;
+      foreach (nodes_type::value_type& n, nodes)
+        if (!n.second.black)
+          garbage.push_back(n.first);
+      if (!garbage.empty())
+      {
+        GD_FINFO_DEBUG("cycle collector: reclaiming %s objects out of %s",
+                       garbage.size(), nodes.size());
+        foreach (const rObject& o, garbage)
+          o->references_clear();
+        LookupCache::invalidate();
+      }
+      size_t res = garbage.size();
+      garbage.clear();
+
+      ++collections;
+      scanned += nodes.size();
+      reclaimed += res;
+      pause_last = libport::utime() - start;
+      pause_max = std::max(pause_max, pause_last);
+      pause_total += pause_last;
+      return res;
+    }
+  }
+}
@@ -0,0 +1,131 @@
+/*
+ * Copyright (C) 2012, Gostai S.A.S.
+ *
+ * This software is provided "as is" without warranty of any kind,
+ * either expressed or implied, including but not limited to the
+ * implied warranties of fitness for a particular purpose.
+ *
+ * See the LICENSE file for more information.
+ */
+
+/**
+ ** \file object/cycle-collector.hh
+ ** \brief Definition of object::CycleCollector.
+ */
+
+#ifndef OBJECT_CYCLE_COLLECTOR_HH
+# define OBJECT_CYCLE_COLLECTOR_HH
+
+# include <cstddef>
+# include <vector>
+
+# include <libport/utime.hh>
+
+# include <urbi/object/fwd.hh>
+
+namespace urbi
+{
+  namespace object
+  {
+    /// Collector of the cycles of objects, which reference counting
+    /// alone never reclaims.
+    ///
+    /// This is the synchronous trial deletion of Bacon and Rajan
+    /// ("Concurrent Cycle Collection in Reference Counted Systems",
+    /// 2001), run on the subgraph reachable from a batch of candidate
+    /// roots: the references internal to the subgraph are subtracted
+    /// from the reference counts (MarkGray).  The objects whose count
+    /// is still positive are referred to from outside, and so is
+    /// everything they reach (Scan).  The remaining objects are only
+    /// referred to by each other: dropping their references
+    /// (CollectWhite) frees them.
+    ///
+    /// The counts are never modified, the trial counts are kept aside,
+    /// so a collection can be abandoned at any point.  References that
+    /// Object::references_get does not report are taken as coming from
+    /// outside: the cycles they close are not collected, but no live
+    /// object is.
+    ///
+    /// Since the decrements of the reference counts cannot be hooked,
+    /// objects become candidates when their references change.  The
+    /// candidates found referred to from outside are dropped, so a
+    /// cycle that was still in use when it was last changed is only
+    /// found once one of its objects changes again.  The candidates
+    /// added during a pass join it, and a pass never restarts from
+    /// scratch, except with collect().
+    class CycleCollector
+    {
+    public:
+      /// Whether candidates are recorded, and collection runs in idle
+      /// time.
+      static bool enabled();
+      /// Bound the duration of the idle time collections to \a budget
+      /// microseconds.  0 disables the collector and forgets the
+      /// candidates.
+      static void budget_set(libport::utime_t budget);
+      static libport::utime_t budget_get();
+
+      /// The references of \a o changed.
+      static void candidate(Object* o);
+      /// \a o is being destroyed.
+      static void forget(Object* o);
+
+      /// Run in idle time, at most until \a deadline, and within the
+      /// budget.
+      static void idle(libport::utime_t deadline);
+      /// Make a complete pass over the candidates, regardless of time.
+      /// \return the number of objects reclaimed.
+      static size_t collect();
+
+      /// \name Statistics.
+      /// \{
+      /// Number of collections.
+      static size_t collections;
+      /// Number of objects traversed.
+      static size_t scanned;
+      /// Number of objects reclaimed.
+      static size_t reclaimed;
+      /// Duration of the last, longest and all collections, in
+      /// microseconds.
+      static libport::utime_t pause_last;
+      static libport::utime_t pause_max;
+      static libport::utime_t pause_total;
+      /// Number of candidates.
+      static size_t candidates_size();
+      /// Reset the counters.
+      static void stats_reset();
+      /// \}
+
+      /// Objects with more references are not traversed: they are
+      /// almost certainly reachable, as are class prototypes.
+      static const long opaque_count = 64;
+      /// Beyond this number of objects, a collection no longer
+      /// traverses objects.
+      static const size_t max_nodes = 16 * 1024;
+
+    private:
+      /// Run a collection from the candidates following the cursor,
+      /// until all the candidates were considered, or \a deadline is
+      /// reached (0 for none).  Return the number of objects reclaimed.
+      static size_t step(libport::utime_t deadline);
+      /// Store \a o at the index \a i of the candidates.
+      static void place_(size_t i, Object* o);
+      /// Remove the candidate at index \a i.
+      static void remove_(size_t i);
+
+      /// The candidates before the cursor were considered by the
+      /// current pass, but the collection did not reach a verdict
+      /// (too many objects): they wait for collect().  The pass ends
+      /// when the cursor reaches the end.
+      typedef std::vector<Object*> candidates_type;
+      static candidates_type candidates_;
+      /// The next candidate to consider.
+      static size_t cursor_;
+      static libport::utime_t budget_;
+    };
+  }
+}
+
+# include <object/cycle-collector.hxx>
+
+#endif // !OBJECT_CYCLE_COLLECTOR_HH
@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2012, Gostai S.A.S.
+ *
+ * This software is provided "as is" without warranty of any kind,
+ * either expressed or implied, including but not limited to the
+ * implied warranties of fitness for a particular purpose.
+ *
+ * See the LICENSE file for more information.
+ */
+
+/**
+ ** \file object/cycle-collector.hxx
+ ** \brief Inline implementation of object::CycleCollector.
+ */
+
+#ifndef OBJECT_CYCLE_COLLECTOR_HXX
+# define OBJECT_CYCLE_COLLECTOR_HXX
+
+# include <object/cycle-collector.hh>
+# include <urbi/object/object.hh>
+
+namespace urbi
+{
+  namespace object
+  {
+    inline bool
+    CycleCollector::enabled()
+    {
+      return budget_;
+    }
+
+    inline libport::utime_t
+    CycleCollector::budget_get()
+    {
+      return budget_;
+    }
+
+    inline void
+    CycleCollector::candidate(Object* o)
+    {
+      if (!budget_ || o->cycle_index_ != -1)
+        return;
+      // New candidates join the running pass, if any.
+      o->cycle_index_ = candidates_.size();
+      candidates_.push_back(o);
+    }
+
+    inline void
+    CycleCollector::forget(Object* o)
+    {
+      if (o->cycle_index_ == -1)
+        return;
+      remove_(o->cycle_index_);
+      o->cycle_index_ = -1;
+    }
+
+    inline void
+    CycleCollector::place_(size_t i, Object* o)
+    {
+      candidates_[i] = o;
+      o->cycle_index_ = i;
+    }
+
+    inline void
+    CycleCollector::remove_(size_t i)
+    {
+      // Keep the candidates already considered before the cursor: fill
+      // the hole with the last of them, and the hole it leaves with the
+      // last candidate.
+      if (i < cursor_)
+      {
+        --cursor_;
+        place_(i, candidates_[cursor_]);
+        i = cursor_;
+      }
+      Object* last = candidates_.back();
+      candidates_.pop_back();
+      if (i < candidates_.size())
+        place_(i, last);
+    }
+
+    inline size_t
+    CycleCollector::candidates_size()
+    {
+      return candidates_.size();
+    }
+  }
+}
+
+#endif // !OBJECT_CYCLE_COLLECTOR_HXX
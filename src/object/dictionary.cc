@@ -15,11 +15,15 @@
 
 #include <libport/containers.hh>
 
+#include <libport/foreach.hh>
+
 #include <urbi/kernel/userver.hh>
 #include <urbi/object/symbols.hh>
 #include <runner/job.hh>
+#include <object/cycle-collector.hh>
 #include <urbi/object/dictionary.hh>
 #include <urbi/object/event.hh>
+#include <urbi/object/float.hh>
 #include <urbi/object/list.hh>
 #include <urbi/object/string.hh>
 
@@ -40,7 +44,14 @@ namespace urbi
     bool
     unordered_map_equal_to::operator()(rObject lhs, rObject rhs) const
     {
-      bool res = from_urbi<bool>(lhs->call("==", rhs));
+      // Plain Strings and Floats compare natively, as their "==" does.
+      if (lhs->bare_instance_of(String::proto))
+        if (rString s = lhs->as<String>())
+          return *s == rhs;
+      if (lhs->bare_instance_of(Float::proto))
+        if (rFloat f = lhs->as<Float>())
+          return *f == rhs;
+      bool res = from_urbi<bool>(lhs->call(SYMBOL(EQ_EQ), rhs));
       return res;
     }
 
@@ -113,18 +124,44 @@ namespace urbi
       }
     }
 
+    void
+    Dictionary::references_get(references_type& res) const
+    {
+      super_type::references_get(res);
+      foreach (const value_type::value_type& e, content_)
+      {
+        res.push_back(e.first.get());
+        res.push_back(e.second.get());
+      }
+      if (elementAdded_)
+        res.push_back(elementAdded_.get());
+      if (elementChanged_)
+        res.push_back(elementChanged_.get());
+      if (elementRemoved_)
+        res.push_back(elementRemoved_.get());
+    }
+
+    void
+    Dictionary::references_clear()
+    {
+      super_type::references_clear();
+      content_.clear();
+      elementAdded_ = 0;
+      elementChanged_ = 0;
+      elementRemoved_ = 0;
+    }
+
     rDictionary
     Dictionary::set(rObject key, rObject val)
     {
-      value_type::iterator it = content_.find(key);
-      if (it == content_.end())
-      {
-        content_[key] = val;
+      CycleCollector::candidate(this);
+      std::pair<value_type::iterator, bool> res =
+        content_.insert(value_type::value_type(key, val));
+      if (res.second)
         elementAdded();
-      }
       else
       {
-        it->second = val;
+        res.first->second = val;
         elementChanged();
       }
       return this;
@@ -134,8 +171,10 @@ namespace urbi
     Dictionary::get(rObject key)
     {
       URBI_AT_HOOK(elementChanged);
-      key_check(key);
-      return content_[key];
+      value_type::iterator i = content_.find(key);
+      if (i == content_.end())
+        key_check(key);
+      return i->second;
     }
 
     rDictionary
@@ -177,8 +216,8 @@ namespace urbi
     rDictionary
     Dictionary::erase(rObject key)
     {
-      key_check(key);
-      content_.erase(key);
+      if (!content_.erase(key))
+        key_check(key);
       elementRemoved();
       return this;
     }
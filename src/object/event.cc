@@ -307,17 +307,26 @@ namespace urbi
             }
           }
           args << pattern;
-          if (h && s->leave_)
+          // Queued notifications register their leave when they run:
+          // they may be dropped.
+          bool queued = async && 0 < s->queueSize_;
+          if (h && s->leave_ && !queued)
             *h << EventHandler::stop_job_type(s, args, detach);
-          if (async)
+          if (queued)
+            s->push_(this, payload, h, detach, args);
+          else if (async)
           {
             // If we create a job, it can die before executing a single line
             // of code.
             // To avoid any race condition, we just create the job without
             // touching any stat or holding any lock.
+            //
+            // All the subscribers share the payload, kept alive by args.
             eval::Action a =
               eval::exec(boost::bind(&Subscription::run_sync,
-                                     s, this, pl, h, detach, false, args),
+                                     s, this,
+                                     boost::cref(payload->value_get()),
+                                     h, detach, false, args),
                          this);
             runner::rJob j =
               new runner::Job(s->lobby, kernel::runner().scheduler_get());
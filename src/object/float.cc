@@ -14,6 +14,9 @@
  */
 
 #include <algorithm>
+#include <typeinfo>
+
+#include <boost/bind.hpp>
 
 #include <libport/cmath>
 #include <libport/cstdlib>
@@ -24,6 +27,7 @@
 #include <libport/ufloat.hh>
 
 #include <object/cxx-helper.hh>
+#include <urbi/object/cxx-primitive.hh>
 #if !defined COMPILATION_MODE_SPACE
 # include <object/format-info.hh>
 #endif
@@ -56,17 +60,78 @@ namespace urbi
       proto_add(model);
     }
 
+    /*---------------------------.
+    | Recycling of temporaries.  |
+    `---------------------------*/
+
+    /// Whether \a o is a plain Float that only the arguments of the
+    /// current call refer to: nobody can tell if its value changes.
+    static inline bool
+    recyclable(const rObject& o)
+    {
+      return o->counter_get() == 1
+        && typeid(*o) == typeid(Float)
+        && o->bare_instance_of(Float::proto);
+    }
+
+    typedef Float::value_type (Float::*unary_type)() const;
+    typedef Float::value_type (Float::*binary_type)(Float::value_type) const;
+
+    /// The arithmetic operators.  Store the result in a temporary
+    /// operand instead of allocating a new Float when possible, so
+    /// that intermediate results of expressions such as `a * b + c'
+    /// cost no allocation.  Bounce to the generic primitive \a generic
+    /// otherwise, which also takes care of the errors.
+    static rObject
+    float_arith_bouncer(const rPrimitive& generic, binary_type op,
+                        const objects_type& args)
+    {
+      if (args.size() == 2)
+      {
+        // Decide before taking references to the operands.
+        int tmp = recyclable(args[1]) ? 1 : recyclable(args[0]) ? 0 : -1;
+        if (tmp != -1)
+        {
+          rFloat lhs = args[0]->as<Float>();
+          rFloat rhs = args[1]->as<Float>();
+          if (lhs && rhs)
+          {
+            // Compute first: the operator may raise.
+            Float::value_type v = ((*lhs).*op)(rhs->value_get());
+            static_cast<Float*>(args[tmp].get())->value_get() = v;
+            return args[tmp];
+          }
+        }
+      }
+      return (*generic)(args);
+    }
+
     URBI_CXX_OBJECT_INIT(Float)
       : value_(0)
     {
-      BIND(PLUS, plus,
-           Float::value_type (Float::*)() const);
-      BIND(PLUS, plus,
-           Float::value_type (Float::*)(Float::value_type) const);
-      BIND(MINUS, minus,
-           Float::value_type (Float::*)() const);
-      BIND(MINUS, minus,
-           Float::value_type (Float::*)(Float::value_type) const);
+#define DECLARE(Urbi, Generic, Cxx)                                     \
+      bind_variadic(SYMBOL_(Urbi),                                      \
+                    boost::bind(&float_arith_bouncer, Generic,          \
+                                static_cast<binary_type>(&Float::Cxx),  \
+                                _1))
+
+      DECLARE(PLUS,
+              primitive(primitive(static_cast<unary_type>(&Float::plus)),
+                        static_cast<binary_type>(&Float::plus)),
+              plus);
+      DECLARE(MINUS,
+              primitive(primitive(static_cast<unary_type>(&Float::minus)),
+                        static_cast<binary_type>(&Float::minus)),
+              minus);
+      DECLARE(STAR,
+              primitive(static_cast<binary_type>(&Float::operator*)),
+              operator*);
+      DECLARE(SLASH,
+              primitive(static_cast<binary_type>(&Float::operator/)),
+              operator/);
+
+#undef DECLARE
+
       BIND(EQ_EQ, operator==,
            bool (self_type::*)(const rObject&) const);
 
@@ -97,8 +162,6 @@ namespace urbi
       BIND(BANG_EQ,   operator!=);
       BIND(LT_LT,     operator<<);
       BIND(PERCENT,   operator%);
-      BIND(SLASH,     operator/);
-      BIND(STAR,      operator*);
       BIND(STAR_STAR, pow);
       BIND(abs,       fabs);
       BIND(acos);
@@ -9,7 +9,10 @@
  */
 
 #include <urbi/object/symbols.hh>
+#include <urbi/object/float.hh>
 #include <urbi/object/hash.hh>
+#include <urbi/object/list.hh>
+#include <urbi/object/string.hh>
 
 namespace urbi
 {
@@ -45,9 +48,49 @@ namespace urbi
       return val_;
     }
 
+    /// The members of \a o if it is a plain Tuple, 0 otherwise.
+    static const List*
+    tuple_members(const Object& o, rObject& tuple)
+    {
+      // Tuple is defined in urbiscript, it might not exist yet.
+      tuple =
+        Object::package_lang_get()->local_slot_get_value(SYMBOL(Tuple));
+      if (!tuple || !o.sole_proto_is(tuple))
+        return 0;
+      // Its only local slot must be "members".
+      const Object::slots_implem& slots = o.slots_get();
+      Object::slots_implem::const_iterator i = slots.begin(&o);
+      if (i == slots.end(&o) || i->first.second != SYMBOL(members)
+          || ++i != slots.end(&o))
+        return 0;
+      return o.local_slot_get_value(SYMBOL(members))->as<List>().get();
+    }
+
     std::size_t
     hash_value(const Object& o)
     {
+      // Plain Strings, Floats, Lists and Tuples, which are the usual
+      // Dictionary keys, are hashed without calling "hash" and
+      // allocating a Hash.  The result must be the same, since equal
+      // objects that derive from them still use "hash".
+      if (o.bare_instance_of(String::proto))
+        if (rString s = const_cast<Object&>(o).as<String>())
+          return boost::hash_value(s->value_get());
+      if (o.bare_instance_of(Float::proto))
+        if (rFloat f = const_cast<Object&>(o).as<Float>())
+          return boost::hash_value(f->value_get());
+      if (o.bare_instance_of(List::proto))
+        if (rList l = const_cast<Object&>(o).as<List>())
+          return l->hash_get();
+      rObject tuple;
+      if (const List* members = tuple_members(o, tuple))
+      {
+        // Tuple.hash: Object.hash on Tuple, combined with the members.
+        std::size_t res =
+          boost::hash_value(static_cast<const Object*>(tuple.get()));
+        boost::hash_combine(res, *members);
+        return res;
+      }
       return from_urbi<rHash>(const_cast<Object&>(o).call("hash"))->value();
     }
 
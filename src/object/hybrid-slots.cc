@@ -0,0 +1,48 @@
+/*
+ * Copyright (C) 2012, Gostai S.A.S.
+ *
+ * This software is provided "as is" without warranty of any kind,
+ * either expressed or implied, including but not limited to the
+ * implied warranties of fitness for a particular purpose.
+ *
+ * See the LICENSE file for more information.
+ */
+
+#include <urbi/object/hybrid-slots.hh>
+
+namespace urbi
+{
+  namespace object
+  {
+    HybridSlots::Storage::Storage()
+      : index(0)
+    {
+    }
+
+    HybridSlots::Storage::~Storage()
+    {
+      delete index;
+    }
+
+    HybridSlots::HybridSlots()
+      : storage_(0)
+    {
+    }
+
+    HybridSlots::HybridSlots(const HybridSlots&)
+      : storage_(0)
+    {
+    }
+
+    HybridSlots&
+    HybridSlots::operator=(const HybridSlots&)
+    {
+      return *this;
+    }
+
+    HybridSlots::~HybridSlots()
+    {
+      delete storage_;
+    }
+  }
+}
@@ -26,10 +26,12 @@
 #include <urbi/object/symbols.hh>
 
 #include <object/code.hh>
+#include <object/cycle-collector.hh>
 #include <urbi/object/event.hh>
 #include <urbi/object/float.hh>
 #include <urbi/object/hash.hh>
 #include <urbi/object/list.hh>
+#include <urbi/object/lookup-cache.hxx>
 #include <urbi/object/object.hh>
 
 #include <urbi/runner/raise.hh>
@@ -45,6 +47,7 @@ namespace urbi
     List::List()
       : sizeChanged_(0)
       , contentChanged_(0)
+      , is_protos_(false)
     {
       proto_add(proto ? rObject(proto) : Object::proto);
     }
@@ -53,6 +56,7 @@ namespace urbi
       : content_(value)
       , sizeChanged_(0)
       , contentChanged_(0)
+      , is_protos_(false)
     {
       proto_add(proto);
     }
@@ -61,6 +65,7 @@ namespace urbi
       : content_(model->content_)
       , sizeChanged_(0)
       , contentChanged_(0)
+      , is_protos_(false)
     {
       proto_add(model);
     }
@@ -68,6 +73,7 @@ namespace urbi
     URBI_CXX_OBJECT_INIT(List)
       : sizeChanged_(0)
       , contentChanged_(0)
+      , is_protos_(false)
     {
       BIND(sort, sort, List::value_type (List::*)());
       BIND(sort, sort, List::value_type (List::*)(rObject));
@@ -110,6 +116,33 @@ namespace urbi
       return content_;
     }
 
+    void
+    List::is_protos_set(bool b)
+    {
+      is_protos_ = b;
+    }
+
+    void
+    List::references_get(references_type& res) const
+    {
+      super_type::references_get(res);
+      foreach (const rObject& o, content_)
+        res.push_back(o.get());
+      if (sizeChanged_)
+        res.push_back(sizeChanged_.get());
+      if (contentChanged_)
+        res.push_back(contentChanged_.get());
+    }
+
+    void
+    List::references_clear()
+    {
+      super_type::references_clear();
+      content_.clear();
+      sizeChanged_ = 0;
+      contentChanged_ = 0;
+    }
+
 #define CHECK_NON_EMPTY()                               \
     do {                                                \
       if (content_.empty())                             \
@@ -407,11 +440,17 @@ namespace urbi
 
     rHash
     List::hash() const
+    {
+      return new Hash(hash_get());
+    }
+
+    std::size_t
+    List::hash_get() const
     {
       URBI_AT_HOOK(contentChanged);
-      rHash res = new Hash(hash_value(proto));
+      std::size_t res = hash_value(proto);
       foreach (const rObject& o, content_)
-        res->combine(o);
+        boost::hash_combine(res, *o);
       return res;
     }
 
@@ -473,6 +512,25 @@ namespace urbi
        SYMBOL(contentChanged)
      */
     URBI_ATTRIBUTE_ON_DEMAND_IMPL(List, Event, sizeChanged);
-    URBI_ATTRIBUTE_ON_DEMAND_IMPL(List, Event, contentChanged);
+
+    // Not URBI_ATTRIBUTE_ON_DEMAND_IMPL: in-place changes of the protos
+    // of an object must invalidate the lookup caches.
+    rEvent
+    List::contentChanged_get() const
+    {
+      if (!contentChanged_)
+        const_cast<List*>(this)->contentChanged_ = new Event;
+      return reinterpret_cast<Event*>(contentChanged_.get());
+    }
+
+    void
+    List::contentChanged()
+    {
+      if (is_protos_)
+        LookupCache::invalidate();
+      CycleCollector::candidate(this);
+      if (contentChanged_)
+        reinterpret_cast<Event*>(contentChanged_.get())->call(SYMBOL(emit));
+    }
   } // namespace object
 }
@@ -149,7 +149,9 @@ namespace urbi
     Lobby::send(const std::string& data, const std::string& tag)
     {
       REQUIRE_DERIVATIVE_AND_CONNECTION();
-      connection_->send(data + "\n", tag.c_str());
+      // Queue the newline separately rather than copying the data.
+      connection_->send(data.c_str(), data.size(), tag.c_str(), false);
+      connection_->send("\n", 1);
     }
 
     void
@@ -11,12 +11,16 @@
 ## ----------------- ##
 
 dist_libuobject@LIBSFX@_la_SOURCES +=		\
+  object/allocator.cc				\
   object/barrier.cc				\
   object/centralized-slots.cc			\
   object/code.hh			        \
   object/code.cc				\
   object/cxx-helper.hh				\
   object/cxx-object.cc				\
+  object/cycle-collector.cc			\
+  object/cycle-collector.hh			\
+  object/cycle-collector.hxx			\
   object/date.cc				\
   object/dictionary.cc				\
   object/directory.cc				\
@@ -32,22 +36,25 @@ dist_libuobject@LIBSFX@_la_SOURCES +=		\
   object/hash-slots.hh				\
   object/hash-slots.hxx				\
   object/hash.cc				\
+  object/hybrid-slots.cc			\
   object/ioservice.cc				\
   object/ioservice.hh				\
   object/job.cc					\
   object/list.cc				\
   object/lobby.cc				\
   object/location.cc				\
+  object/lookup-cache.cc			\
   object/matrix.cc				\
   object/object-class.cc			\
   object/object-class.hh			\
   object/object.cc				\
-  object/object-size.cc				\
   object/path.cc				\
   object/position.cc				\
   object/primitive.cc				\
   object/profile.cc				\
   object/profile.hh				\
+  object/pubsub.cc				\
+  object/pubsub.hh				\
   object/register.cc				\
   object/root-classes.cc			\
   object/root-classes.hh			\
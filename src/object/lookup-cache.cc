@@ -0,0 +1,44 @@
+/*
+ * Copyright (C) 2012, Gostai S.A.S.
+ *
+ * This software is provided "as is" without warranty of any kind,
+ * either expressed or implied, including but not limited to the
+ * implied warranties of fitness for a particular purpose.
+ *
+ * See the LICENSE file for more information.
+ */
+
+/**
+ ** \file object/lookup-cache.cc
+ ** \brief Implementation of object::LookupCache.
+ */
+
+#include <urbi/object/lookup-cache.hxx>
+
+namespace urbi
+{
+  namespace object
+  {
+    // Entries are created with version 0, make sure they start stale.
+    unsigned LookupCache::version_ = 1;
+
+    size_t LookupCache::hits = 0;
+    size_t LookupCache::misses = 0;
+    size_t LookupCache::invalidations = 0;
+
+    LookupCache::LookupCache()
+      : next_(0)
+    {
+    }
+
+    LookupCache::~LookupCache()
+    {
+    }
+
+    void
+    LookupCache::stats_reset()
+    {
+      hits = misses = invalidations = 0;
+    }
+  }
+}
@@ -34,7 +34,9 @@
 #include <urbi/object/global.hh>
 #include <urbi/object/hash.hh>
 #include <urbi/object/list.hh>
+#include <urbi/object/lookup-cache.hxx>
 #include <urbi/object/object.hh>
+#include <object/cycle-collector.hh>
 #include <object/root-classes.hh>
 #include <urbi/object/symbols.hh>
 #include <urbi/object/urbi-exception.hh>
@@ -45,7 +47,11 @@
 #include <eval/send-message.hh>
 #include <eval/call.hh>
 
-#include <urbi/object/centralized-slots.hxx>
+#if defined URBI_CENTRALIZED_SLOTS
+# include <urbi/object/centralized-slots.hxx>
+#else
+# include <urbi/object/hybrid-slots.hxx>
+#endif
 GD_CATEGORY(Urbi.Object);
 
 
@@ -87,20 +93,92 @@ namespace urbi
       , protos_(0)
       , slots_()
       , lookup_id_(INT_MAX)
+      , cycle_index_(-1)
     {
     }
 
     Object::~Object ()
     {
+      CycleCollector::forget(this);
       slots_.finalize(this);
       if (!protos_cache_)
         delete protos_;
     }
 
+    /*-------------.
+    | Allocation.  |
+    `-------------*/
+
+    AllocationStats Object::allocation_stats("Object", sizeof(Object));
+
+    void*
+    Object::operator new(size_t size)
+    {
+      allocation_stats.allocated();
+      return SizeClassAllocator::allocate(size);
+    }
+
+    void
+    Object::operator delete(void* p, size_t size)
+    {
+      allocation_stats.released();
+      SizeClassAllocator::deallocate(p, size);
+    }
+
     /*--------.
     | Slots.  |
     `--------*/
 
+    /*-------------------.
+    | Cycle collection.  |
+    `-------------------*/
+
+    void
+    Object::references_get(references_type& res) const
+    {
+      if (proto_)
+        res.push_back(proto_.get());
+      // When there is a cache, it owns protos_.
+      if (protos_cache_)
+        res.push_back(protos_cache_.get());
+      else if (protos_)
+        foreach (const rObject& p, *protos_)
+          res.push_back(p.get());
+      for (slots_implem::const_iterator i = slots_.begin(this);
+           i != slots_.end(this); ++i)
+        if (i->second)
+          res.push_back(i->second.get());
+      if (slotAdded_)
+        res.push_back(slotAdded_.get());
+      if (slotRemoved_)
+        res.push_back(slotRemoved_.get());
+    }
+
+    void
+    Object::references_clear()
+    {
+      slots_.finalize(this);
+      if (!protos_cache_)
+        delete protos_;
+      protos_ = 0;
+      protos_cache_ = 0;
+      proto_ = 0;
+      slotAdded_ = 0;
+      slotRemoved_ = 0;
+    }
+
+    bool
+    Object::sole_proto_is(const rObject& p) const
+    {
+      return !protos_ && proto_ == p;
+    }
+
+    bool
+    Object::bare_instance_of(const rObject& p) const
+    {
+      return sole_proto_is(p) && slots_.begin(this) == slots_.end(this);
+    }
+
     rList
     Object::urbi_protos_get()
     {
@@ -122,12 +200,16 @@ namespace urbi
       }
       protos_cache_ = protos;
       protos_ = &protos->value_get();
+      protos->is_protos_set(true);
+      LookupCache::invalidate();
       return protos;
     }
 
     void
     Object::proto_set(const rObject& o)
     {
+      if (proto_ || protos_)
+        LookupCache::invalidate();
       if (!protos_cache_)
         delete protos_;
       protos_cache_ = 0;
@@ -147,8 +229,11 @@ namespace urbi
       {
         protos_cache_ = l;
         protos_ = &l->value_get();
+        l->is_protos_set(true);
         proto_ = 0;
       }
+      LookupCache::invalidate();
+      CycleCollector::candidate(this);
     }
 
     static int lookup_id = 0;
@@ -227,6 +312,36 @@ namespace urbi
       return res;
     }
 
+    Object::location_type
+    Object::slot_locate(key_type k, bool fallback, LookupCache& cache) const
+    {
+      // Dependency tracking relies on the hooks run by the walk over
+      // every object of the hierarchy.
+      if (runner::Job::dependencies_logging())
+      {
+        runner::Job* r = ::kernel::urbiserver->getCurrentRunnerOpt();
+        if (r && r->dependencies_log_get())
+          return slot_locate(k, fallback);
+      }
+
+      if (Object* owner = cache.find(this, k))
+        if (rObject slot = owner->slots_.get(owner, k))
+        {
+          ++LookupCache::hits;
+          return location_type(owner, slot);
+        }
+      ++LookupCache::misses;
+      Object::location_type res = slot_locate(k, false);
+      if (res.first)
+        cache.store(this, res.first);
+      else if (fallback)
+      {
+        ++lookup_id;
+        res = slot_locate_(SYMBOL(fallback));
+      }
+      return res;
+    }
+
     Object::location_type
     Object::safe_slot_locate(key_type k) const
     {
@@ -255,7 +370,24 @@ namespace urbi
       location_type loc = throwOnFailure?safe_slot_locate(k):slot_locate(k);
       if (!loc.first)
         return 0;
+      return slot_get_(k, loc);
+    }
+
+    rObject
+    Object::slot_get(key_type k, LookupCache& cache) const
+    {
+      location_type loc = slot_locate(k, true, cache);
+      if (!loc.first)
+        runner::raise_lookup_error(k, const_cast<Object*>(this));
+      return slot_get_(k, loc);
+    }
+
+    rObject
+    Object::slot_get_(key_type k, location_type& loc) const
+    {
       rObject res = loc.second;
+      if (!runner::Job::dependencies_logging())
+        return res;
       runner::Job* r = ::kernel::urbiserver->getCurrentRunnerOpt();
       if (r && r->dependencies_log_get() && !res->as<Slot>())
       {
@@ -307,6 +439,7 @@ namespace urbi
         GD_FINFO_DEBUG("Slot redefinition: %s", k);
         runner::raise_urbi_skip(SYMBOL(Redefinition), to_urbi(k));
       }
+      CycleCollector::candidate(this);
       if (!fastHook)
         slotAdded();
       return *this;
@@ -383,6 +516,8 @@ namespace urbi
             return o;
         }
 
+      CycleCollector::candidate(this);
+
       // If return-value of hook is not void, write it to slot.
       // Copy on write check
       // Assumes copy on write is on by default.
@@ -593,7 +728,7 @@ namespace urbi
 
     std::ostream&
     Object::slot_dump(std::ostream& o,
-                      const CentralizedSlots::q_slot_type& s,
+                      const slots_implem::q_slot_type& s,
                       int depth_max) const
     {
       rSlot slot = s.second->as<Slot>();
@@ -768,6 +903,10 @@ namespace urbi
           return *this;
         else if (!proto_)
         {
+          // This is how constructors set up the proto of fresh
+          // objects: do not invalidate the caches on every object
+          // construction.  addProto takes care of the case of an
+          // object that lost all its protos.
           proto_ = p;
           return *this;
         }
@@ -777,11 +916,17 @@ namespace urbi
           protos_->push_back(p);
           protos_->push_back(proto_);
           proto_ = 0;
+          LookupCache::invalidate();
+          CycleCollector::candidate(this);
           return *this;
         }
       }
       if (!libport::has(*protos_, p))
+      {
         protos_->push_front(p);
+        LookupCache::invalidate();
+        CycleCollector::candidate(this);
+      }
       return *this;
     }
 
@@ -1008,6 +1153,7 @@ namespace urbi
         FRAISE("cannot inherit from a %1% without being one",
                proto->type_name_get());
       proto_add(proto);
+      LookupCache::invalidate();
       return this;
     }
 
@@ -0,0 +1,254 @@
+/*
+ * Copyright (C) 2012, Gostai S.A.S.
+ *
+ * This software is provided "as is" without warranty of any kind,
+ * either expressed or implied, including but not limited to the
+ * implied warranties of fitness for a particular purpose.
+ *
+ * See the LICENSE file for more information.
+ */
+
+#include <algorithm>
+
+#include <libport/debug.hh>
+#include <libport/format.hh>
+
+#include <urbi/kernel/userver.hh>
+#include <urbi/object/list.hh>
+#include <urbi/object/symbols.hh>
+#include <urbi/runner/raise.hh>
+
+#include <object/pubsub.hh>
+#include <runner/job.hh>
+
+GD_CATEGORY(Urbi.Object.PubSub);
+
+namespace urbi
+{
+  namespace object
+  {
+
+    /*-------------.
+    | Subscriber.  |
+    `-------------*/
+
+    /// Initial capacity of unbounded queues, doubled when full.
+    static const size_t queue_initial_capacity = 16;
+
+    Subscriber::Subscriber()
+      : capacity_(0)
+      , dropped_(0)
+      , queue_(queue_initial_capacity)
+      , drop_newest_(false)
+    {
+      proto_add(proto ? rObject(proto) : Object::proto);
+    }
+
+    Subscriber::Subscriber(rSubscriber model)
+      : capacity_(model->capacity_)
+      , dropped_(0)
+      , queue_(model->queue_.capacity())
+      , drop_newest_(model->drop_newest_)
+    {
+      proto_add(model);
+    }
+
+    URBI_CXX_OBJECT_INIT(Subscriber)
+      : capacity_(0)
+      , dropped_(0)
+      , queue_(queue_initial_capacity)
+      , drop_newest_(false)
+    {
+#define DECLARE(Name, Ret, Arg)                 \
+      BIND(Name, Name, Ret, Arg)
+
+      DECLARE(getAll, rList, ());
+      DECLARE(getAll, rList, (unsigned));
+      DECLARE(init, void, ());
+      DECLARE(init, void, (unsigned));
+      DECLARE(init, void, (unsigned, const std::string&));
+
+#undef DECLARE
+
+      BINDG(capacity, capacity_get);
+      BINDG(dropped, dropped_get);
+      BIND(enqueue);
+      BIND(getOne);
+      BINDG(size);
+    }
+
+    void
+    Subscriber::init()
+    {
+      init(0);
+    }
+
+    void
+    Subscriber::init(unsigned capacity)
+    {
+      init(capacity, "dropOldest");
+    }
+
+    void
+    Subscriber::init(unsigned capacity, const std::string& policy)
+    {
+      if (policy == "dropOldest")
+        drop_newest_ = false;
+      else if (policy == "dropNewest")
+        drop_newest_ = true;
+      else
+        FRAISE("invalid drop policy: %s", policy);
+      capacity_ = capacity;
+      queue_.clear();
+      queue_.set_capacity(capacity ? capacity : queue_initial_capacity);
+      dropped_ = 0;
+    }
+
+    size_t
+    Subscriber::size() const
+    {
+      return queue_.size();
+    }
+
+    void
+    Subscriber::enqueue(rObject ev)
+    {
+      if (queue_.full())
+      {
+        if (!capacity_)
+          queue_.set_capacity(queue_.capacity() * 2);
+        else
+        {
+          ++dropped_;
+          // The ring buffer overwrites the oldest value by itself.
+          if (drop_newest_)
+            return;
+        }
+      }
+      queue_.push_back(ev);
+      wake_();
+    }
+
+    rObject
+    Subscriber::getOne()
+    {
+      wait_();
+      rObject res = queue_.front();
+      queue_.pop_front();
+      return res;
+    }
+
+    rList
+    Subscriber::getAll()
+    {
+      wait_();
+      return take_(queue_.size());
+    }
+
+    rList
+    Subscriber::getAll(unsigned count)
+    {
+      if (!count)
+        runner::raise_non_positive_number_error(count);
+      wait_();
+      return take_(std::min(size_t(count), queue_.size()));
+    }
+
+    rList
+    Subscriber::take_(size_t count)
+    {
+      rList res = new List;
+      List::value_type& values = res->value_get();
+      for (size_t i = 0; i < count; ++i)
+      {
+        values.push_back(queue_.front());
+        queue_.pop_front();
+      }
+      return res;
+    }
+
+    // Waiters are queued in arrival order, and each enqueued value
+    // releases the first of them.  A released job that finds the queue
+    // empty again (another job was faster) goes back to the head of the
+    // queue, so that it does not lose its turn.
+    void
+    Subscriber::wait_()
+    {
+      runner::Job& r = ::kernel::runner();
+      bool released = false;
+      while (queue_.empty())
+      {
+        waiters_type::iterator i =
+          waiters_.insert(released ? waiters_.begin() : waiters_.end(), &r);
+        try
+        {
+          r.frozen_set(true);
+          GD_FINFO_TRACE("%p: Waiting", &r);
+          r.yield();
+          GD_FINFO_TRACE("%p: Waking-up", &r);
+        }
+        catch (...)
+        {
+          // Still frozen means still queued, otherwise the value we
+          // were released for must be handed to the next waiter.
+          if (r.frozen_get())
+          {
+            waiters_.erase(i);
+            r.frozen_set(false);
+          }
+          else if (!queue_.empty())
+            wake_();
+          throw;
+        }
+        released = true;
+      }
+    }
+
+    void
+    Subscriber::wake_()
+    {
+      if (waiters_.empty())
+        return;
+      waiters_.front()->frozen_set(false);
+      waiters_.pop_front();
+    }
+
+
+    /*---------.
+    | PubSub.  |
+    `---------*/
+
+    PubSub::PubSub()
+    {
+      proto_add(proto ? rObject(proto) : Object::proto);
+    }
+
+    PubSub::PubSub(rPubSub model)
+    {
+      proto_add(model);
+    }
+
+    URBI_CXX_OBJECT_INIT(PubSub)
+    {
+      BIND(publish);
+    }
+
+    rObject
+    PubSub::publish(rObject ev)
+    {
+      rList subscribers =
+        from_urbi<rList>(slot_get_value(SYMBOL(subscribers)));
+      const List::value_type& subs = subscribers->value_get();
+      // Subscribers that are not native may run code that changes the
+      // list, so do not keep iterators on it.  Derived subscribers, or
+      // ones with slots, may override enqueue: call it.
+      for (size_t i = 0; i < subs.size(); ++i)
+        if (subs[i]->bare_instance_of(Subscriber::proto))
+          subs[i].unsafe_cast<Subscriber>()->enqueue(ev);
+        else
+          subs[i]->call(SYMBOL(enqueue), ev);
+      return ev;
+    }
+
+  } // namespace object
+}
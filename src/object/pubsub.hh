@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2012, Gostai S.A.S.
+ *
+ * This software is provided "as is" without warranty of any kind,
+ * either expressed or implied, including but not limited to the
+ * implied warranties of fitness for a particular purpose.
+ *
+ * See the LICENSE file for more information.
+ */
+
+/**
+ ** \file object/pubsub.hh
+ ** \brief Definition of the Urbi objects PubSub and PubSub.Subscriber.
+ */
+
+#ifndef OBJECT_PUBSUB_HH
+# define OBJECT_PUBSUB_HH
+
+# include <list>
+
+# include <boost/circular_buffer.hpp>
+
+# include <libport/attributes.hh>
+
+# include <urbi/object/cxx-object.hh>
+# include <urbi/object/fwd.hh>
+# include <runner/job.hh>
+
+namespace urbi
+{
+  namespace object
+  {
+
+    /*-------------.
+    | Subscriber.  |
+    `-------------*/
+
+    class URBI_SDK_API Subscriber: public CxxObject
+    {
+      URBI_CXX_OBJECT(Subscriber, CxxObject);
+    public:
+      /// The pending values, oldest first.
+      typedef boost::circular_buffer<rObject> queue_type;
+      /// The jobs waiting for a value, in arrival order.
+      typedef std::list<runner::rJob> waiters_type;
+
+      Subscriber();
+      Subscriber(rSubscriber model);
+
+      /// Keep at most \a capacity values, 0 meaning no bound.  When
+      /// full, \a policy is "dropOldest" or "dropNewest".
+      void init();
+      void init(unsigned capacity);
+      void init(unsigned capacity, const std::string& policy);
+
+      /// Queue \a ev, and wake up the first waiting job.
+      void enqueue(rObject ev);
+      /// Block until a value is queued, and dequeue it.
+      rObject getOne();
+      /// Block until a value is queued, and dequeue all of them.
+      rList getAll();
+      /// Block until a value is queued, and dequeue at most \a count.
+      rList getAll(unsigned count);
+      /// Number of queued values.
+      size_t size() const;
+
+      ATTRIBUTE_R(unsigned, capacity);
+      /// Number of values discarded because the queue was full.
+      ATTRIBUTE_R(unsigned, dropped);
+
+    private:
+      /// Block until the queue is not empty.
+      void wait_();
+      /// Wake up the first waiting job, if any.
+      void wake_();
+      /// Dequeue at most \a count values.
+      rList take_(size_t count);
+
+      queue_type queue_;
+      /// Whether a full queue discards the incoming value rather than
+      /// the oldest one.
+      bool drop_newest_;
+      waiters_type waiters_;
+    };
+
+
+    /*---------.
+    | PubSub.  |
+    `---------*/
+
+    class URBI_SDK_API PubSub: public CxxObject
+    {
+      URBI_CXX_OBJECT(PubSub, CxxObject);
+    public:
+      PubSub();
+      PubSub(rPubSub model);
+
+      /// Queue \a ev in each of the subscribers, and return it.
+      rObject publish(rObject ev);
+    };
+
+  } // namespace object
+}
+
+#endif // !OBJECT_PUBSUB_HH
@@ -50,6 +50,7 @@
 #include <object/finalizable.hh>
 #include <object/ioservice.hh>
 #include <object/profile.hh>
+#include <object/pubsub.hh>
 #include <object/semaphore.hh>
 #include <object/server.hh>
 #include <object/socket.hh>
@@ -99,6 +100,8 @@ namespace urbi
     URBI_CXX_OBJECT_REGISTER(UConnection);
     URBI_CXX_OBJECT_REGISTER(Profile);
     URBI_CXX_OBJECT_REGISTER(FunctionProfile, Profile);
+    URBI_CXX_OBJECT_REGISTER(PubSub);
+    URBI_CXX_OBJECT_REGISTER(Subscriber, PubSub);
     URBI_CXX_OBJECT_REGISTER(Matrix);
     URBI_CXX_OBJECT_REGISTER(Vector);
     URBI_CXX_OBJECT_REGISTER(Subscription);
@@ -8,6 +8,8 @@
  * See the LICENSE file for more information.
  */
 
+#include <libport/foreach.hh>
+
 #include <urbi/object/global.hh>
 #include <urbi/object/slot.hh>
 #include <urbi/object/slot.hxx>
@@ -26,6 +28,7 @@ namespace urbi
   namespace object
   {
     URBI_CXX_OBJECT_INIT(Slot)
+      : ext_(0)
     {
       Ward w(this);
       // The BIND below will create slots that will use this, aka proto,
@@ -35,28 +38,28 @@ namespace urbi
       init();
       // FIXME: bind get/set mechanism in urbiscript
       bind("n", &Slot::normalized, &Slot::normalized_set);
-      BIND(dead, dead_);
-      BIND(split, split_);
-      BIND(owned, split_); // for backward
+      bind("dead", &Slot::dead_get, &Slot::dead_set);
+      bind("split", &Slot::split_get, &Slot::split_set);
+      bind("owned", &Slot::split_get, &Slot::split_set); // for backward
       BIND(value, value_);
       BIND(timestamp, timestamp_);
       BIND(outputValue, output_value_);
-      BIND(rangemax, rangemax_);
-      BIND(rangemin, rangemin_);
+      bind("rangemax", &Slot::rangemax_get, &Slot::rangemax_set);
+      bind("rangemin", &Slot::rangemin_get, &Slot::rangemin_set);
       bind("set", &Slot::set_get, &Slot::set_set);
       bind("get", &Slot::get_get, &Slot::get_set);
       bind("oset", &Slot::oset_get, &Slot::oset_set);
       bind("oget", &Slot::oget_get, &Slot::oget_set);
-      BIND(constant, constant_);
+      bind("constant", &Slot::constant_get, &Slot::constant_set);
       bind("rtp", &Slot::rtp_get, &Slot::rtp_set);
       slot_remove(SYMBOL(type));
-      BIND(type, type_);
+      bind("type", &Slot::type_get, &Slot::type_set);
       BIND(get_get); // debug
       BIND(set_get);
       BIND(oget_get); // debug
       BIND(oset_get);
-      BIND(updateHook, updateHook_);
-      BIND(copyOnWrite, copyOnWrite_);
+      bind("updateHook", &Slot::updateHook_get, &Slot::updateHook_set);
+      bind("copyOnWrite", &Slot::copyOnWrite_get, &Slot::copyOnWrite_set);
       BIND(setOutputValue, set_output_value);
       BIND(pushPullCheck, push_pull_check);
       BIND(update_timed);
@@ -68,6 +71,14 @@ namespace urbi
       s->constant_set(true);
     }
 
+    Slot::Extension::Extension()
+      : rangemax(std::numeric_limits<libport::ufloat>::infinity())
+      , rangemin(-std::numeric_limits<libport::ufloat>::infinity())
+      , waiter_count(0)
+      , in_getter(0)
+    {
+    }
+
     rObject
     Slot::property_get(libport::Symbol k)
     {
@@ -98,6 +109,25 @@ namespace urbi
       slot_remove(k);
     }
 
+    void
+    Slot::references_get(references_type& res) const
+    {
+      super_type::references_get(res);
+      if (value_)
+        res.push_back(value_.get());
+      if (output_value_)
+        res.push_back(output_value_.get());
+      if (!ext_)
+        return;
+      const rObject* refs[] = { &ext_->changed, &ext_->type,
+                                &ext_->get, &ext_->set,
+                                &ext_->oget, &ext_->oset,
+                                &ext_->updateHook, &ext_->waiter_tag };
+      foreach (const rObject* r, refs)
+        if (*r)
+          res.push_back(r->get());
+    }
+
     // FIXME: Does not work with changed.
     Slot::properties_type*
     Slot::properties_get()
@@ -134,12 +164,14 @@ namespace urbi
     Slot::set(rObject value, Object* sender, libport::utime_t timestamp)
     {
       static rObject void_object = capture(SYMBOL(void), Object::package_lang_get());
+      // Plain slots have no extension: no type, range, nor hooks.
+      Extension* e = ext_;
       GD_FINFO_DUMP("Slot::set, slot %s, sender %s, oset %s",
-        this, sender, !!oset_);
-      if (type_)
+        this, sender, e && e->oset);
+      if (e && e->type)
       {
-        if (!value->call(SYMBOL(isA), type_)->as_bool())
-          runner::raise_type_error(value/*->call(SYMBOL(type))?*/, type_);
+        if (!value->call(SYMBOL(isA), e->type)->as_bool())
+          runner::raise_type_error(value/*->call(SYMBOL(type))?*/, e->type);
       }
       timestamp_ = timestamp / 1000000.0;
       has_uvalue_ = false;
@@ -150,40 +182,46 @@ namespace urbi
         if (uval->value_get().type == urbi::DATA_DOUBLE)
         {
           ufloat f = uval->value_get().val;
-          f = std::min(rangemax_, std::max(f, rangemin_));
+          if (e)
+            f = std::min(e->rangemax, std::max(f, e->rangemin));
           value = to_urbi(f);
         }
         else
           has_uvalue_ = true;
       }
-      else if (rFloat vf = value->as<Float>())
+      else if (e)
       {
-        ufloat f = vf->value_get();
-        ufloat tf = std::min(rangemax_, std::max(f, rangemin_));
-        // Do not touch the input if unchanged.
-        if (tf != f)
+        if (rFloat vf = value->as<Float>())
         {
-          // Ideally we should call new on vf, but we can't
-          value = to_urbi(tf);
+          ufloat f = vf->value_get();
+          ufloat tf = std::min(e->rangemax, std::max(f, e->rangemin));
+          // Do not touch the input if unchanged.
+          if (tf != f)
+          {
+            // Ideally we should call new on vf, but we can't
+            value = to_urbi(tf);
+          }
         }
       }
-      if (set_)
+      rObject setter = e ? e->set : 0;
+      rObject osetter = e && sender ? e->oset : 0;
+      if (setter)
       {
         object::objects_type args;
         args << value;
         rObject res = eval::call_apply(::kernel::runner(),
-                         const_cast<Slot*>(this), set_, SYMBOL(set), args);
+                         const_cast<Slot*>(this), setter, SYMBOL(set), args);
         if (res != void_object)
           value_ = res;
       }
-      if (sender && oset_)
+      if (osetter)
       {
-        if (set_) // Re-fetch the value that might have been modified by set
+        if (setter) // Re-fetch the value that might have been modified by set
           value = value_;
         object::objects_type args;
         args << sender << value << this;
         rObject res = eval::call_apply(::kernel::runner(),
-                         oset_.get(), SYMBOL(oset), args, 0,
+                         osetter.get(), SYMBOL(oset), args, 0,
                          boost::optional< ::ast::loc>(),
                           Primitive::CALL_IGNORE_EXTRA_ARGS
                          );
@@ -198,7 +236,7 @@ namespace urbi
         runner::raise_const_error();
 
       // Write input if no setter was called
-      if (!set_ && (!oset_ || !sender))
+      if (!setter && !osetter)
         value_ = value;
 
       if (!split_) // input->output in non-split mode
@@ -210,32 +248,32 @@ namespace urbi
     {
       URBI_SCOPE_DISABLE_DEPENDENCY_TRACKER;
       GD_FINFO_DUMP("Slot::set_output_value, slot %s, val %s changed %s ",
-                    this, v, changed_);
+                    this, v, ext_ && ext_->changed);
       output_value_ = v;
       has_uvalue_ = v->as<UValue>();
       check_waiters();
       // Both optim and let us run the init phase with no runner.
-      if (!changed_)
+      if (!ext_ || !ext_->changed)
         return;
       runner::Job& r = ::kernel::runner();
-      bool isIn = libport::has(in_setter_, &r);
+      std::vector<void*>& in_setter = ext_->in_setter;
+      bool isIn = libport::has(in_setter, &r);
       if (!isIn)
       {
         GD_FINFO_DUMP("set_output_value on %s: disabling notifies", this);
-        in_setter_.push_back(&r);
-        FINALLY(((std::vector<void*>&, in_setter_))
+        in_setter.push_back(&r);
+        FINALLY(((std::vector<void*>&, in_setter))
                 ((runner::Job&, r)),
-                for (unsigned i=0; i<in_setter_.size(); ++i)
-                  if (in_setter_[i] == &r)
+                for (unsigned i=0; i<in_setter.size(); ++i)
+                  if (in_setter[i] == &r)
                   {
-                    if (i != in_setter_.size()-1)
-                      in_setter_[in_setter_.size()-1] = in_setter_[i];
-                    in_setter_.pop_back();
+                    if (i != in_setter.size()-1)
+                      in_setter[in_setter.size()-1] = in_setter[i];
+                    in_setter.pop_back();
                   }
                   );
         objects_type nothing;
-        if (changed_)
-          changed_->as<object::Event>()->syncEmit(nothing);
+        ext_->changed->as<object::Event>()->syncEmit(nothing);
       }
     }
 
@@ -244,7 +282,7 @@ namespace urbi
     {
       // If there are blocked reads, call extract to force caching of the
       // temporary value, and unblock them.
-      if (waiter_count_)
+      if (ext_ && ext_->waiter_count)
       {
         // Split val declaration and assignment to work around g++
         // 4.3.3 which warns:
@@ -255,8 +293,8 @@ namespace urbi
         val = (split_ ? output_value_ : value_)->as<UValue>();
         if (val)
           val->extract();
-        if (waiter_tag_)
-          waiter_tag_->call(SYMBOL(stop));
+        if (ext_->waiter_tag)
+          ext_->waiter_tag->call(SYMBOL(stop));
       }
     }
 
@@ -264,13 +302,18 @@ namespace urbi
     Slot::init(bool fromModel)
     {
       has_uvalue_ = false;
-      oget_ = oset_ = get_ = set_ = 0;
-      type_ = 0;
+      if (ext_)
+      {
+        ext_->oget = ext_->oset = ext_->get = ext_->set = 0;
+        ext_->type = 0;
+        ext_->in_getter = 0;
+        ext_->waiter_count = 0;
+        ext_->rangemax = std::numeric_limits<libport::ufloat>::infinity();
+        ext_->rangemin = -std::numeric_limits<libport::ufloat>::infinity();
+      }
       rSlot model;
       if (fromModel)
         model = protos_get_first()->as<Slot>();
-      in_getter_ = 0;
-      waiter_count_ = 0;
       dead_ = false;
       push_pull_loop_ = false;
       if (!model || model == this)
@@ -282,8 +325,6 @@ namespace urbi
         value_ = void_class;
         output_value_ = void_class;
         timestamp_ = 0;
-        rangemax_ = std::numeric_limits<libport::ufloat>::infinity();
-        rangemin_ = -std::numeric_limits<libport::ufloat>::infinity();
       }
       else
       {
@@ -294,21 +335,31 @@ namespace urbi
         value_ = model->value_;
         output_value_ = model->output_value_;
         timestamp_ = model->timestamp_;
-        rangemax_ = model->rangemax_;
-        rangemin_ = model->rangemin_;
-        if (model->set_)
-          set_ = model->set_->call(SYMBOL(new));
-        if (model->get_)
-          get_ = model->get_->call(SYMBOL(new));
-        if (model->oset_)
-          oset_ = model->oset_->call(SYMBOL(new));
-        if (model->oget_)
-          oget_ = model->oget_->call(SYMBOL(new));
+        // Do not allocate an extension for what the copy does not
+        // inherit (e.g., the changed event).
+        const Extension* m = model->ext_;
+        if (m && (m->set || m->get || m->oset || m->oget
+                  || m->rangemax != rangemax_get()
+                  || m->rangemin != rangemin_get()))
+        {
+          Extension& e = ext();
+          e.rangemax = m->rangemax;
+          e.rangemin = m->rangemin;
+          if (m->set)
+            e.set = m->set->call(SYMBOL(new));
+          if (m->get)
+            e.get = m->get->call(SYMBOL(new));
+          if (m->oset)
+            e.oset = m->oset->call(SYMBOL(new));
+          if (m->oget)
+            e.oget = m->oget->call(SYMBOL(new));
+        }
       }
       return void_class;
     }
 
     Slot::Slot(rSlot model)
+      : ext_(0)
     {
       Ward w(this);
       aver(model);
@@ -318,6 +369,7 @@ namespace urbi
 
     Slot::Slot(const Slot& model)
       : CxxObject()
+      , ext_(0)
       , has_uvalue_(false)
     {
       //std::cerr <<"slot copy " << &model <<" -> " << this
@@ -335,23 +387,25 @@ namespace urbi
     rObject
     Slot::value_special(Object* sender, bool fromUObject) const
     {
-      if (in_getter_ > 3)
+      // Without extension, there are no getters: we are here for a UValue.
+      Extension* e = ext_;
+      if (e && e->in_getter > 3)
       {
         // Some level of reentrency is possible when using a getter that writes
         // using set_output_value and watchers(at).
-        if (in_getter_ > 3)
-          GD_FWARN("Possible loop detected accessing slot %s", this);
+        GD_FWARN("Possible loop detected accessing slot %s", this);
         return split_ ? output_value_ : value_;
       }
-      FINALLY(((int&, in_getter_)), --in_getter_);
-      ++in_getter_;
+      FINALLY(((Extension*, e)), if (e) --e->in_getter);
+      if (e)
+        ++e->in_getter;
       rObject res;
-      if (sender && oget_)
+      if (e && sender && e->oget)
       {
         object::objects_type args;
         args << sender << const_cast<Slot*>(this);
         /*
-        if (rPrimitive p = oget_->as<Primitive>())
+        if (rPrimitive p = e->oget->as<Primitive>())
         {
           res = p->call_raw(args, Primitive::CALL_IGNORE_EXTRA_ARGS);
         }
@@ -359,7 +413,7 @@ namespace urbi
         {
 
          res = eval::call_apply(::kernel::runner(),
-                                 oget_.get(),
+                                 e->oget.get(),
                                  SYMBOL(oget),
                                  args,
                                  0,
@@ -368,12 +422,12 @@ namespace urbi
                                  );
         }
       }
-      if (get_)
+      if (e && e->get)
       {
         object::objects_type args;
         res = eval::call_apply(::kernel::runner(),
                               const_cast<Slot*>(this),
-                              get_, SYMBOL(get), args);
+                              e->get, SYMBOL(get), args);
       }
       if (!res)
         res = split_ ? output_value_ : value_;
@@ -396,9 +450,9 @@ namespace urbi
             // free the shared ptrs
             res.reset();
             bv.reset();
-            ++waiter_count_;
+            ++ext().waiter_count;
             waiter_tag()->call(SYMBOL(waitUntilStopped), new Float(0.5));
-            --waiter_count_;
+            --ext_->waiter_count;
             // The val slot likely changed, fetch it again.
             res = split_ ? output_value_ : value_;
             if (rUValue bv = res->as<UValue>())
@@ -417,13 +471,15 @@ namespace urbi
     float
     Slot::normalized()
     {
-      if (!std::isfinite(rangemin_) || !std::isfinite(rangemax_))
+      ufloat min = rangemin_get();
+      ufloat max = rangemax_get();
+      if (!std::isfinite(min) || !std::isfinite(max))
         RAISE("ranges are not finite");
       rObject v = value();
       if (rFloat rf = v->as<Float>())
       {
         ufloat f = rf->value_get();
-        return (f - rangemin_) / (rangemax_ - rangemin_);
+        return (f - min) / (max - min);
       }
       else
         FRAISE("Value is not a float");
@@ -432,46 +488,89 @@ namespace urbi
     void
     Slot::normalized_set(float v)
     {
-      if (!std::isfinite(rangemin_) || !std::isfinite(rangemax_))
+      ufloat min = rangemin_get();
+      ufloat max = rangemax_get();
+      if (!std::isfinite(min) || !std::isfinite(max))
         FRAISE("ranges are not finite");
-      ufloat tv = v*(rangemax_-rangemin_) + rangemin_;
+      ufloat tv = v*(max-min) + min;
       set(to_urbi(tv));
     }
 
     rTag
     Slot::waiter_tag() const
     {
-      if (!waiter_tag_)
-        waiter_tag_ = new Tag();
-      return waiter_tag_->as<Tag>();
+      Extension& e = ext();
+      if (!e.waiter_tag)
+        e.waiter_tag = new Tag();
+      return e.waiter_tag->as<Tag>();
     }
 
+    // Resetting a hook on a slot without extension is a no-op, do not
+    // allocate one for it.
     void
     Slot::get_set(const rObject& o)
     {
-      bool had_one = get_ || oget_;
-      get_ = o == nil_class ? 0 : o;
-      push_pull_check(!had_one && (get_ || oget_));
+      if (!ext_ && (!o || o == nil_class))
+        return;
+      Extension& e = ext();
+      bool had_one = e.get || e.oget;
+      e.get = o == nil_class ? 0 : o;
+      push_pull_check(!had_one && (e.get || e.oget));
     }
 
     void
     Slot::oget_set(const rObject& o)
     {
-      bool had_one = get_ || oget_;
-      oget_ = o == nil_class ? 0 : o;
-      push_pull_check(!had_one && (get_ || oget_));
+      if (!ext_ && (!o || o == nil_class))
+        return;
+      Extension& e = ext();
+      bool had_one = e.get || e.oget;
+      e.oget = o == nil_class ? 0 : o;
+      push_pull_check(!had_one && (e.get || e.oget));
     }
 
     void
     Slot::oset_set(const rObject& o)
     {
-      oset_ = o == nil_class ? 0 : o;
+      if (!ext_ && (!o || o == nil_class))
+        return;
+      ext().oset = o == nil_class ? 0 : o;
     }
 
     void
     Slot::set_set(const rObject& o)
     {
-      set_ = o == nil_class ? 0 : o;
+      if (!ext_ && (!o || o == nil_class))
+        return;
+      ext().set = o == nil_class ? 0 : o;
+    }
+
+    void
+    Slot::type_set(const rObject& o)
+    {
+      if (!ext_ && !o)
+        return;
+      ext().type = o;
+    }
+
+    void
+    Slot::updateHook_set(const rObject& o)
+    {
+      if (!ext_ && !o)
+        return;
+      ext().updateHook = o;
+    }
+
+    void
+    Slot::rangemax_set(ufloat v)
+    {
+      ext().rangemax = v;
+    }
+
+    void
+    Slot::rangemin_set(ufloat v)
+    {
+      ext().rangemin = v;
     }
 
     rObject
@@ -490,25 +589,27 @@ namespace urbi
 
         // We must protect against reetrant calls to changed as it confuses
         // the dependency tracker, as is done in setter().
+        // The loop only runs on slots with a getter, hence an extension.
         runner::Job& r = ::kernel::runner();
-        bool isIn = libport::has(in_setter_, &r);
+        std::vector<void*>& in_setter = ext_->in_setter;
+        bool isIn = libport::has(in_setter, &r);
         if (!isIn)
         {
           GD_FINFO_DUMP("set_output_value on %s: disabling notifies", this);
-          in_setter_.push_back(&r);
-          FINALLY(((std::vector<void*>&, in_setter_))
+          in_setter.push_back(&r);
+          FINALLY(((std::vector<void*>&, in_setter))
             ((runner::Job&, r)),
-            for (unsigned i=0; i<in_setter_.size(); ++i)
-              if (in_setter_[i] == &r)
+            for (unsigned i=0; i<in_setter.size(); ++i)
+              if (in_setter[i] == &r)
               {
-                if (i != in_setter_.size()-1)
-                  in_setter_[in_setter_.size()-1] = in_setter_[i];
-                in_setter_.pop_back();
+                if (i != in_setter.size()-1)
+                  in_setter[in_setter.size()-1] = in_setter[i];
+                in_setter.pop_back();
               }
               );
           objects_type nothing;
-          if (changed_)
-            changed_->as<object::Event>()->syncEmit(nothing);
+          if (ext_->changed)
+            ext_->changed->as<object::Event>()->syncEmit(nothing);
         }
         //changed_->as<Event>()->syncEmit();
         rObject period = System->call(SYMBOL(period));
@@ -524,14 +625,17 @@ namespace urbi
 
       // Activate if there is at least one getter and at least one
       // notifychange-like.
+      if (!ext_)
+        return false;
+      rObject changed = ext_->changed;
       bool need_loop =
        !push_pull_loop_ &&
-       (get_ || oget_) &&
-       (changed_ && changed_->as<Event>()->hasSubscribers()) &&
+       (ext_->get || ext_->oget) &&
+       (changed && changed->as<Event>()->hasSubscribers()) &&
        hasLocalSlot(SYMBOL(watchIncompatible))
        ;
        /*std::cerr <<"ppchecking "<< push_pull_loop_ <<" " << need_loop << " "
-       << (changed_ && changed_->as<Event>()->hasSubscribers())
+       << (changed && changed->as<Event>()->hasSubscribers())
        << std::endl;*/
       if (need_loop)
       {
@@ -546,7 +650,7 @@ namespace urbi
         nr->state.tag_stack_clear();
         nr->start_job();
       }
-      if (!need_loop && first_getter && changed_)
+      if (!need_loop && first_getter && changed)
       {
         GD_FINFO_TRACE("hookChanged %s", this);
         call(SYMBOL(hookChangedEvent));
@@ -561,13 +665,14 @@ namespace urbi
     {
       URBI_SCOPE_DISABLE_DEPENDENCY_TRACKER;
       CAPTURE_GLOBAL(Event);
-      if (!changed_)
+      Extension& e = ext();
+      if (!e.changed)
       {
-        changed_ = Event->call(SYMBOL(new));
-        GD_FPUSH_TRACE("Creating changed for %s: %s", this, changed_);
-        push_pull_check(get_ || oget_);
+        e.changed = Event->call(SYMBOL(new));
+        GD_FPUSH_TRACE("Creating changed for %s: %s", this, e.changed);
+        push_pull_check(e.get || e.oget);
       }
-      return changed_;
+      return e.changed;
     }
 
     void
@@ -582,6 +687,7 @@ namespace urbi
     }
 
     Slot::Slot(rObject& val)
+      : ext_(0)
     {
       //Ward w(this);
       if (!proto)
@@ -593,6 +699,5 @@ namespace urbi
       has_uvalue_ = val?(bool)val->as<UValue>():false;
     }
 
-    const size_t Slot::allocator_static_max_size = sizeof(Slot);
   }
 }
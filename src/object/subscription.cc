@@ -43,6 +43,7 @@ namespace urbi
       BIND(minInterval, minInterval_);
       BIND(onEvent, onEvent_);
       BIND(processing, processing_);
+      BIND(queueSize, queueSize_);
       BIND(stop);
       BIND(totalCallTime, totalCallTime_);
     }
@@ -76,6 +77,7 @@ namespace urbi
       cb_ = model->cb_;
       enabled_ = model->enabled_get();
       minInterval_ = model->minInterval_get();
+      queueSize_ = model->queueSize_get();
       onEvent_ = model->onEvent_get();
     }
 
@@ -94,6 +96,7 @@ namespace urbi
       disconnected_ = false;
       processing_ = 0;
       minInterval_ = 0;
+      queueSize_ = 0;
       if (!proto || this == proto)
         lastCall_ = 0;
       else
@@ -116,6 +119,9 @@ namespace urbi
     Subscription::stop()
     {
       disconnected_set(true);
+      queue_.clear();
+      // A worker killed before it ran would keep us alive.
+      worker_ = 0;
       lobby = 0;
       delete cb_;
       cb_ = 0;
@@ -225,6 +231,70 @@ namespace urbi
         run_(leave_, args, detach);
     }
 
+    /*----------------.
+    | Notifications.  |
+    `----------------*/
+
+    Subscription::Notification::Notification(rEvent s, rList p,
+                                             rEventHandler eh, bool d,
+                                             const objects_type& a)
+      : src(s)
+      , payload(p)
+      , h(eh)
+      , detach(d)
+      , args(a)
+    {}
+
+    void
+    Subscription::push_(rEvent src, rList payload, EventHandler* h,
+                        bool detach, const objects_type& args)
+    {
+      aver(0 < queueSize_);
+      while (queueSize_ <= int(queue_.size()))
+      {
+        GD_FINFO_DUMP("%s: queue full, dropping oldest notification", this);
+        queue_.pop_front();
+      }
+      queue_.push_back(Notification(src, payload, rEventHandler(h), detach,
+                                    args));
+      // The worker may have been killed before it started, in which
+      // case it did not reset worker_.
+      if (worker_ && !worker_->terminated())
+        return;
+      eval::Action a =
+        eval::exec(boost::bind(&Subscription::drain_, rSubscription(this)),
+                   this);
+      worker_ = new runner::Job(lobby, kernel::runner().scheduler_get());
+      worker_->set_action(a);
+      worker_->state.tag_stack_set(tag_stack);
+      GD_FINFO_DUMP("%s: notifications will run in job %s", this, worker_);
+      worker_->start_job();
+    }
+
+    void
+    Subscription::drain_()
+    {
+      // If a notification throws, the next push_ starts a new worker
+      // for the remaining ones.
+      FINALLY(((runner::rJob&, worker_)), worker_ = 0);
+      while (!queue_.empty())
+      {
+        Notification n = queue_.front();
+        queue_.pop_front();
+        if (n.h)
+        {
+          // Skip the notifications of instances that already ended, and
+          // register the leave of the others.
+          if (n.src->active_get().find(n.h) == n.src->active_get().end())
+            continue;
+          if (leave_)
+            *n.h << EventHandler::stop_job_type(this, n.args, n.detach);
+        }
+        run_sync(n.src, n.payload->value_get(), n.h.get(), n.detach, false,
+                 n.args);
+      }
+    }
+
     void
     Subscription::run_sync(rEvent src,
                            const objects_type& pl, EventHandler* h,
@@ -13,6 +13,7 @@
  ** \brief Creation of the Urbi object system.
  */
 
+#include <fstream>
 #include <memory>
 #include <sstream>
 
@@ -30,12 +31,15 @@
 #include <urbi/kernel/userver.hh>
 
 #include <object/code.hh>
+#include <object/cycle-collector.hh>
+#include <urbi/object/allocator.hh>
 #include <urbi/object/cxx-primitive.hh>
 #include <urbi/object/dictionary.hh>
 #include <urbi/object/urbi-exception.hh>
 #include <urbi/object/float.hh>
 #include <urbi/object/global.hh>
 #include <urbi/object/list.hh>
+#include <urbi/object/lookup-cache.hh>
 #include <urbi/object/object.hh>
 #include <urbi/object/path.hh>
 #include <object/profile.hh>
@@ -44,9 +48,11 @@
 #include <object/system.hh>
 #include <urbi/object/tag.hh>
 #include <urbi/object/job.hh>
+#include <parser/ast-cache.hh>
 #include <parser/transform.hh>
 #include <runner/exception.hh>
 #include <runner/job.hh>
+#include <runner/scheduler-stats.hh>
 #include <runner/shell.hh>
 #include <runner/state.hh>
 #include <urbi/runner/raise.hh>
@@ -84,11 +90,10 @@ namespace urbi
     {
 
       static rObject
-      execute_parsed(parser::parse_result_type p, rObject self)
+      execute_transformed(ast::rConstAst ast, rObject self)
       {
         // We execute as if the code was in the current context.
         // But said code may contain import directives.
-        ast::rConstAst ast = parser::transform(ast::rConstExp(p));
         runner::Job& run = runner();
         runner::State& state = run.state;
         if (!state.has_import_stack)
@@ -117,6 +122,13 @@ namespace urbi
                             self ? self : rObject(run.state.lobby_get()));
       }
 
+      static rObject
+      execute_parsed(parser::parse_result_type p, rObject self)
+      {
+        return execute_transformed(parser::transform(ast::rConstExp(p)),
+                                   self);
+      }
+
     }
 
     rObject system_class;
@@ -281,7 +293,7 @@ namespace urbi
 #endif
       try
       {
-        return execute_parsed(parser::parse_file(filename), self);
+        return execute_transformed(parser::transform_file(filename), self);
       }
       catch (const runner::Exception& e)
       {
@@ -308,6 +320,16 @@ namespace urbi
       runner().non_interruptible_set(true);
     }
 
+    /// The buckets of \a h, as a List.
+    static rList
+    histogram(const runner::SchedulerStats::Histogram& h)
+    {
+      List::value_type res;
+      for (unsigned i = 0; i < h.size; ++i)
+        res.push_back(new Float(h[i]));
+      return new List(res);
+    }
+
     static boost::optional<Dictionary::value_type>
     system_stats()
     {
@@ -332,13 +354,106 @@ namespace urbi
       ADDSTAT(StdDev, standard_deviation, 1e6);
       ADDSTAT(Variance, variance, 1e3);
 #undef ADDSTAT
+
+      typedef runner::SchedulerStats SS;
+      res[new String("cyclesHistogram")] = histogram(SS::cycles);
+      res[new String("slicesHistogram")] = histogram(SS::slices);
+#define ADDSTAT(Name, Value)                    \
+      res[new String(#Name)] = new Float(Value)
+      ADDSTAT(jobsResumed, SS::resumed_total);
+      ADDSTAT(jobsResumedMax, SS::resumed_max);
+      ADDSTAT(jobsYielded, SS::yielded_total);
+      ADDSTAT(jobsYieldedMax, SS::yielded_max);
+      ADDSTAT(jobsFrozen, SS::frozen_total);
+      ADDSTAT(jobsFrozenMax, SS::frozen_max);
+#undef ADDSTAT
+      Dictionary::value_type worst;
+      foreach (const SS::jobs_type::value_type& j, SS::worst_jobs())
+        worst[new String(j.first)] = new Float(j.second / 1e6);
+      res[new String("worstJobs")] = new Dictionary(worst);
+      return res;
+    }
+
+    static size_t
+    system_dumpSchedulerTrace(const std::string& path)
+    {
+      std::ofstream o(path.c_str());
+      if (!o)
+        FRAISE("%1%: %2%", strerror(errno), path);
+      return runner::SchedulerStats::trace_dump(o);
+    }
+
+    static Dictionary::value_type
+    system_allocationStats()
+    {
+      Dictionary::value_type res;
+      foreach (const AllocationStats* s, AllocationStats::instances())
+      {
+        Dictionary::value_type d;
+        d[new String("allocations")] = new Float(s->allocations);
+        d[new String("live")] = new Float(s->live);
+        d[new String("peak")] = new Float(s->peak);
+        d[new String("size")] = new Float(s->size);
+        res[new String(s->name)] = new Dictionary(d);
+      }
       return res;
     }
 
+    static Dictionary::value_type
+    system_lookupStats()
+    {
+      Dictionary::value_type res;
+#define ADDSTAT(Name, Value)                    \
+      res[new String(#Name)] = new Float(Value)
+      ADDSTAT(hits, LookupCache::hits);
+      ADDSTAT(misses, LookupCache::misses);
+      ADDSTAT(invalidations, LookupCache::invalidations);
+      size_t lookups = LookupCache::hits + LookupCache::misses;
+      ADDSTAT(hitRatio,
+              lookups ? double(LookupCache::hits) / lookups : 0.);
+#undef ADDSTAT
+      return res;
+    }
+
+    static Dictionary::value_type
+    system_cycleStats()
+    {
+      Dictionary::value_type res;
+#define ADDSTAT(Name, Value)                    \
+      res[new String(#Name)] = new Float(Value)
+      ADDSTAT(budget, CycleCollector::budget_get());
+      ADDSTAT(candidates, CycleCollector::candidates_size());
+      ADDSTAT(collections, CycleCollector::collections);
+      ADDSTAT(scanned, CycleCollector::scanned);
+      ADDSTAT(reclaimed, CycleCollector::reclaimed);
+      ADDSTAT(lastPause, CycleCollector::pause_last);
+      ADDSTAT(maxPause, CycleCollector::pause_max);
+      ADDSTAT(totalPause, CycleCollector::pause_total);
+#undef ADDSTAT
+      return res;
+    }
+
+    static size_t
+    system_collectCycles()
+    {
+      return CycleCollector::collect();
+    }
+
+    static void
+    system_setCycleCollector(libport::utime_t budget)
+    {
+      if (budget < 0)
+        RAISE("argument 1 must be non-negative");
+      CycleCollector::budget_set(budget);
+    }
+
     static void
     system_resetStats()
     {
       ::kernel::scheduler().stats_reset();
+      LookupCache::stats_reset();
+      CycleCollector::stats_reset();
+      runner::SchedulerStats::stats_reset();
     }
 
     static void
@@ -684,8 +799,12 @@ namespace urbi
       {
         libport::utime_t deadline = ::kernel::scheduler().deadline_get();
         if (deadline != sched::SCHED_IMMEDIATE)
+        {
+          // Collect cycles while there is nothing else to do.
+          CycleCollector::idle(deadline);
           select_time = std::max(deadline - libport::utime(),
                                (libport::utime_t)0);
+        }
       }
       static bool interactive =
         system_class->call(SYMBOL(interactive))->as_bool();
@@ -799,15 +918,20 @@ namespace urbi
       system_class->bind(SYMBOL_(Name), &system_##Name, 0)
       DECLARE(_exit);
       DECLARE(addSystemFile);
+      DECLARE(allocationStats);
       DECLAREG(arguments);
       DECLARE(breakpoint);
+      DECLARE(collectCycles);
       DECLAREG(cycle);
+      DECLARE(cycleStats);
+      DECLARE(dumpSchedulerTrace);
       DECLARE(getLocale);
       DECLARE(getenv);
       DECLAREG(hostName);
       DECLARE(interactive);
       DECLARE(loadLibrary);
       DECLARE(loadModule);
+      DECLARE(lookupStats);
       DECLAREG(noVoidError);
       DECLAREG(nonInterruptible);
       DECLARE(poll);
@@ -818,6 +942,7 @@ namespace urbi
       DECLAREG(redefinitionMode);
       DECLARE(resetStats);
       DECLARE(searchFile);
+      DECLARE(setCycleCollector);
       DECLARE(setSystemFiles);
       DECLARE(setenv);
       DECLAREG(shiftedTime);
@@ -121,7 +121,12 @@ namespace urbi
       allocated_ = !bypass;
       value_.set(v, !bypass);
       if (value_.type == DATA_BINARY)
+      {
         value_.binary->temporary_ = false;
+        // Shallow readers share the payload instead of aliasing it.
+        if (!bypass)
+          value_.binary->share();
+      }
       cache_ = 0;
     }
 
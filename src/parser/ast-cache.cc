@@ -0,0 +1,127 @@
+/*
+ * Copyright (C) 2012, Gostai S.A.S.
+ *
+ * This software is provided "as is" without warranty of any kind,
+ * either expressed or implied, including but not limited to the
+ * implied warranties of fitness for a particular purpose.
+ *
+ * See the LICENSE file for more information.
+ */
+
+/// \file parser/ast-cache.cc
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+#include <boost/functional/hash.hpp>
+
+#include <libport/cstdlib>
+#include <libport/debug.hh>
+#include <libport/format.hh>
+#include <libport/unistd.h>
+
+#include <kernel/config.h>
+
+#include <ast/exp.hh>
+#if defined ENABLE_SERIALIZATION
+# include <ast/serialize.hh>
+#endif
+#include <parser/ast-cache.hh>
+#include <parser/parse.hh>
+#include <parser/transform.hh>
+#include <urbi/package-info.hh>
+
+GD_CATEGORY(Urbi.Parser);
+
+namespace parser
+{
+#if defined ENABLE_SERIALIZATION
+  namespace
+  {
+    /// The cache directory, empty if disabled.
+    static const std::string&
+    cache_dir()
+    {
+      static const std::string res =
+        getenv("URBI_AST_CACHE") ? getenv("URBI_AST_CACHE") : "";
+      return res;
+    }
+
+    /// The file holding the AST of \a file, whose contents is \a content.
+    static std::string
+    cache_file(const std::string& file, const std::string& content)
+    {
+      size_t key = 0;
+      boost::hash_combine(key, ::urbi::package_info().signature());
+      boost::hash_combine(key, file);
+      boost::hash_combine(key, content);
+      return libport::format("%s/%x-%x.ast", cache_dir(), key,
+                             content.size());
+    }
+
+    static ast::rExp
+    cache_load(const std::string& cache)
+    {
+      std::ifstream is(cache.c_str(), std::ios::binary);
+      if (!is)
+        return 0;
+      try
+      {
+        ast::rAst res = ast::unserialize(is);
+        GD_FINFO_DEBUG("AST cache hit: %s", cache);
+        return res.unsafe_cast<ast::Exp>();
+      }
+      catch (const std::exception& e)
+      {
+        GD_FWARN("ignoring invalid AST cache %s: %s", cache, e.what());
+        return 0;
+      }
+    }
+
+    static void
+    cache_save(const std::string& cache, ast::rConstExp ast)
+    {
+      // Write to a private file first: other servers may be reading
+      // the cache.
+      std::string tmp = libport::format("%s.%s", cache, getpid());
+      {
+        std::ofstream os(tmp.c_str(), std::ios::binary);
+        if (os)
+          ast::serialize(ast, os);
+        if (!os)
+        {
+          GD_FWARN("cannot write AST cache %s", tmp);
+          unlink(tmp.c_str());
+          return;
+        }
+      }
+      if (rename(tmp.c_str(), cache.c_str()))
+        unlink(tmp.c_str());
+    }
+  }
+#endif
+
+  ast::rExp
+  transform_file(const std::string& file)
+  {
+#if defined ENABLE_SERIALIZATION
+    if (!cache_dir().empty())
+    {
+      std::ifstream is(file.c_str(), std::ios::binary);
+      std::stringstream content;
+      content << is.rdbuf();
+      if (is)
+      {
+        std::string cache = cache_file(file, content.str());
+        if (ast::rExp res = cache_load(cache))
+          return res;
+        ast::rExp res = transform(ast::rConstExp(parse_file(file)));
+        cache_save(cache, res);
+        return res;
+      }
+    }
+#endif
+    return transform(ast::rConstExp(parse_file(file)));
+  }
+}
@@ -0,0 +1,33 @@
+/*
+ * Copyright (C) 2012, Gostai S.A.S.
+ *
+ * This software is provided "as is" without warranty of any kind,
+ * either expressed or implied, including but not limited to the
+ * implied warranties of fitness for a particular purpose.
+ *
+ * See the LICENSE file for more information.
+ */
+
+/// \file parser/ast-cache.hh
+
+#ifndef PARSER_AST_CACHE_HH
+# define PARSER_AST_CACHE_HH
+
+# include <string>
+
+# include <ast/fwd.hh>
+# include <urbi/export.hh>
+
+namespace parser
+{
+  /// Parse and transform the file \a file.
+  ///
+  /// If the environment variable URBI_AST_CACHE names a directory, the
+  /// transformed AST is saved there, keyed by the name and contents of
+  /// the file and by the kernel version.  Later loads of the same file
+  /// then skip the parsing and the transformations.
+  ast::rExp URBI_SDK_API
+  transform_file(const std::string& file);
+}
+
+#endif // !PARSER_AST_CACHE_HH
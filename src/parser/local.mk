@@ -7,6 +7,8 @@
 ## See the LICENSE file for more information.
 
 dist_libuobject@LIBSFX@_la_SOURCES +=		\
+  parser/ast-cache.hh				\
+  parser/ast-cache.cc				\
   parser/fwd.hh					\
   parser/is-keyword.hh				\
   parser/is-keyword.cc				\
@@ -20,6 +20,7 @@
 #include <urbi/object/fwd.hh>
 
 #include <runner/job.hh>
+#include <runner/scheduler-stats.hh>
 
 #include <eval/call.hh>
 #include <eval/raise.hh>
@@ -34,8 +35,13 @@
 
 namespace runner
 {
+  unsigned Job::dependencies_loggers_ = 0;
+
   Job::~Job()
   {
+    SchedulerStats::terminated(*this);
+    if (dependencies_log_)
+      --dependencies_loggers_;
   }
 
 
@@ -115,7 +121,10 @@ namespace runner
 
   bool Job::frozen() const
   {
-    return state.frozen();
+    bool res = state.frozen();
+    if (res)
+      SchedulerStats::frozen(frozen_counted_);
+    return res;
   }
 
   size_t Job::has_tag(const sched::Tag& tag, size_t max_depth) const
@@ -142,7 +151,9 @@ namespace runner
   const std::string
   Job::name_get() const
   {
-    if (!terminated() && job_cache_)
+    // The cache is kept until terminate_cleanup, so that the slice a
+    // terminating job ran is attributed to it.
+    if (job_cache_)
       if (urbi::object::rObject s =
           job_cache_->local_slot_get_value(SYMBOL(name)))
         return s->as<object::String>()->value_get();
@@ -207,6 +218,7 @@ namespace runner
   void
   Job::hook_preempted() const
   {
+    SchedulerStats::preempted(*this);
     if (profile_)
       profile_->preempted(profile_info_);
   }
@@ -214,6 +226,7 @@ namespace runner
   void
   Job::hook_resumed() const
   {
+    SchedulerStats::resumed(*this);
     if (profile_)
       profile_->resumed(profile_info_);
   }
@@ -41,26 +41,27 @@
 #define URBI_AT_HOOK_(accessor)                                         \
   do                                                                    \
   {                                                                     \
-    if (runner::Job* r =                                                \
-        ::kernel::urbiserver->getCurrentRunnerOpt())                    \
-      if (r->dependencies_log_get())                                    \
-      {                                                                 \
-        try                                                             \
+    if (runner::Job::dependencies_logging())                            \
+      if (runner::Job* r =                                              \
+          ::kernel::urbiserver->getCurrentRunnerOpt())                  \
+        if (r->dependencies_log_get())                                  \
         {                                                               \
-          r->dependencies_log_set(false);                               \
-          GD_CATEGORY(Urbi.At);                                         \
-          GD_FPUSH_TRACE("Register %s for at monitoring on %s", #accessor, \
-                         this);                                         \
-          rEvent e = accessor()->as<Event>();                           \
-          r->dependencies_log_set(true);                                \
-          r->dependency_add(e);                                         \
+          try                                                           \
+          {                                                             \
+            r->dependencies_log_set(false);                             \
+            GD_CATEGORY(Urbi.At);                                       \
+            GD_FPUSH_TRACE("Register %s for at monitoring on %s",       \
+                           #accessor, this);                            \
+            rEvent e = accessor()->as<Event>();                         \
+            r->dependencies_log_set(true);                              \
+            r->dependency_add(e);                                       \
+          }                                                             \
+          catch (...)                                                   \
+          {                                                             \
+            r->dependencies_log_set(true);                              \
+            throw;                                                      \
+          }                                                             \
         }                                                               \
-        catch (...)                                                     \
-        {                                                               \
-          r->dependencies_log_set(true);                                \
-          throw;                                                        \
-        }                                                               \
-      }                                                                 \
   }                                                                     \
   while (false)
 
@@ -237,9 +238,15 @@ namespace runner
     void dependency_add(object::rEvent evt);
     void dependency_add(object::rObject evt);
     void dependencies_clear();
+    /// Whether some job is logging its dependencies.  Checked first
+    /// by the hooks, so that they cost nothing while no at/watch
+    /// condition is being evaluated.
+    static bool dependencies_logging();
   protected:
     bool dependencies_log_;
     dependencies_type dependencies_;
+    /// Number of jobs whose dependencies_log_ is set.
+    static unsigned dependencies_loggers_;
 
     /// \}
 
@@ -259,6 +266,8 @@ namespace runner
     eval::Action worker_;
     rObject result_cache_;
     object::rJob job_cache_;
+    /// The last scheduler cycle this job was counted frozen in.
+    mutable size_t frozen_counted_;
   };
 
 } // namespace runner
@@ -18,6 +18,8 @@
 // necesary for "dependencies_"
 # include <urbi/object/event.hh>
 
+# include <runner/scheduler-stats.hh>
+
 namespace runner
 {
 
@@ -35,6 +37,7 @@ namespace runner
     , worker_()
     , result_cache_()
     , job_cache_()
+    , frozen_counted_(0)
   {
   }
 
@@ -50,6 +53,7 @@ namespace runner
     , worker_()
     , result_cache_()
     , job_cache_()
+    , frozen_counted_(0)
   {
   }
 
@@ -88,6 +92,8 @@ namespace runner
     * to deadlock if a socket is stored in our state.
     */
     GD_FINFO_TRACE("Cleaning state for job %s", this);
+    // The job may not have yielded since it was resumed.
+    SchedulerStats::terminated(*this);
     // Do not keep a reference on a job which keeps a reference onto
     // ourselves.
     job_cache_ = 0;
@@ -183,9 +189,17 @@ namespace runner
   LIBPORT_SPEED_ALWAYS_INLINE void
   Job::dependencies_log_set(bool v)
   {
+    if (v != dependencies_log_)
+      v ? ++dependencies_loggers_ : --dependencies_loggers_;
     dependencies_log_ = v;
   }
 
+  LIBPORT_SPEED_ALWAYS_INLINE bool
+  Job::dependencies_logging()
+  {
+    return dependencies_loggers_;
+  }
+
   LIBPORT_SPEED_ALWAYS_INLINE bool
   Job::dependencies_log_get() const
   {
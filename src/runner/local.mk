@@ -16,6 +16,9 @@ dist_libuobject@LIBSFX@_la_SOURCES +=		\
   runner/state.hh				\
   runner/state.hxx				\
   runner/raise.cc				\
+  runner/scheduler-stats.cc			\
+  runner/scheduler-stats.hh			\
+  runner/scheduler-stats.hxx			\
   runner/shell.cc				\
   runner/shell.hh				\
   runner/sneaker.cc				\
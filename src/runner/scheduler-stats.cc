@@ -0,0 +1,188 @@
+/*
+ * Copyright (C) 2012, Gostai S.A.S.
+ *
+ * This software is provided "as is" without warranty of any kind,
+ * either expressed or implied, including but not limited to the
+ * implied warranties of fitness for a particular purpose.
+ *
+ * See the LICENSE file for more information.
+ */
+
+/**
+ ** \file runner/scheduler-stats.cc
+ ** \brief Implementation of runner::SchedulerStats.
+ */
+
+#include <algorithm>
+#include <iostream>
+
+#include <libport/foreach.hh>
+
+#include <runner/job.hh>
+#include <runner/scheduler-stats.hh>
+
+namespace runner
+{
+  /*----------------------------.
+  | SchedulerStats::Histogram.  |
+  `----------------------------*/
+
+  SchedulerStats::Histogram::Histogram()
+  {
+    reset();
+  }
+
+  void
+  SchedulerStats::Histogram::reset()
+  {
+    std::fill(buckets_, buckets_ + size, 0);
+  }
+
+
+  /*------------------------.
+  | SchedulerStats::Cycle.  |
+  `------------------------*/
+
+  SchedulerStats::Cycle::Cycle()
+    : start(0)
+    , duration(0)
+    , resumed(0)
+    , yielded(0)
+    , frozen(0)
+    , slice_max(0)
+    , job()
+  {
+  }
+
+
+  /*-----------------.
+  | SchedulerStats.  |
+  `-----------------*/
+
+  SchedulerStats::Histogram SchedulerStats::cycles;
+  SchedulerStats::Histogram SchedulerStats::slices;
+  size_t SchedulerStats::resumed_total = 0;
+  size_t SchedulerStats::yielded_total = 0;
+  size_t SchedulerStats::frozen_total = 0;
+  unsigned SchedulerStats::resumed_max = 0;
+  unsigned SchedulerStats::yielded_max = 0;
+  unsigned SchedulerStats::frozen_max = 0;
+
+  SchedulerStats::Cycle SchedulerStats::cycle_;
+  SchedulerStats::jobs_type SchedulerStats::worst_;
+  libport::utime_t SchedulerStats::slice_start_ = 0;
+  const Job* SchedulerStats::slice_job_ = 0;
+  size_t SchedulerStats::cycle_number_ = 0;
+  SchedulerStats::trace_type SchedulerStats::trace_;
+  size_t SchedulerStats::trace_next_ = 0;
+
+  void
+  SchedulerStats::cycle_begin(libport::utime_t now)
+  {
+    cycle_ = Cycle();
+    cycle_.start = now;
+    ++cycle_number_;
+  }
+
+  void
+  SchedulerStats::cycle_end(libport::utime_t now)
+  {
+    if (slice_start_)
+      slice_end(now);
+    cycle_.duration = now - cycle_.start;
+    cycles.add(cycle_.duration);
+
+    resumed_total += cycle_.resumed;
+    yielded_total += cycle_.yielded;
+    frozen_total += cycle_.frozen;
+    resumed_max = std::max(resumed_max, cycle_.resumed);
+    yielded_max = std::max(yielded_max, cycle_.yielded);
+    frozen_max = std::max(frozen_max, cycle_.frozen);
+
+    if (trace_.size() < trace_size)
+      trace_.push_back(cycle_);
+    else
+      trace_[trace_next_] = cycle_;
+    trace_next_ = (trace_next_ + 1) % trace_size;
+  }
+
+  void
+  SchedulerStats::slice_end(libport::utime_t now)
+  {
+    libport::utime_t d = now - slice_start_;
+    const Job* job = slice_job_;
+    slice_start_ = 0;
+    slice_job_ = 0;
+    slices.add(d);
+
+    // The longest slice of the cycle and the worst jobs are
+    // independent: the second longest slice of a cycle may still be
+    // one of the worst ones.
+    bool longest = cycle_.slice_max < d;
+    bool worst = (worst_.size() < worst_size
+                  || worst_.back().second < d);
+    if (!longest && !worst)
+      return;
+
+    std::string name = job->name_get();
+    if (longest)
+    {
+      cycle_.slice_max = d;
+      cycle_.job = name;
+    }
+    if (!worst)
+      return;
+
+    // Keep one entry per job, sorted by decreasing slice.
+    jobs_type::iterator i = worst_.begin();
+    while (i != worst_.end() && i->first != name)
+      ++i;
+    if (i == worst_.end())
+    {
+      if (worst_.size() == worst_size)
+        worst_.pop_back();
+      i = worst_.insert(worst_.end(), std::make_pair(name, d));
+    }
+    else if (d <= i->second)
+      return;
+    i->second = d;
+    for (; i != worst_.begin() && (i - 1)->second < i->second; --i)
+      std::swap(*i, *(i - 1));
+  }
+
+  void
+  SchedulerStats::stats_reset()
+  {
+    cycles.reset();
+    slices.reset();
+    resumed_total = yielded_total = frozen_total = 0;
+    resumed_max = yielded_max = frozen_max = 0;
+    worst_.clear();
+    trace_.clear();
+    trace_next_ = 0;
+  }
+
+  size_t
+  SchedulerStats::trace_dump(std::ostream& o)
+  {
+    o << "start,duration,resumed,yielded,frozen,sliceMax,job\n";
+    // Once the trace is full, the oldest cycle is the next to go.
+    size_t first = trace_.size() < trace_size ? 0 : trace_next_;
+    for (size_t n = 0; n < trace_.size(); ++n)
+    {
+      const Cycle& c = trace_[(first + n) % trace_.size()];
+      o << c.start << ','
+        << c.duration << ','
+        << c.resumed << ','
+        << c.yielded << ','
+        << c.frozen << ','
+        << c.slice_max << ",\"";
+      // Quotes are doubled in quoted CSV fields.
+      foreach (char ch, c.job)
+        o << (ch == '"' ? "\"\"" : std::string(1, ch));
+      o << "\"\n";
+    }
+    o.flush();
+    return trace_.size();
+  }
+}
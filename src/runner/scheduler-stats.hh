@@ -0,0 +1,148 @@
+/*
+ * Copyright (C) 2012, Gostai S.A.S.
+ *
+ * This software is provided "as is" without warranty of any kind,
+ * either expressed or implied, including but not limited to the
+ * implied warranties of fitness for a particular purpose.
+ *
+ * See the LICENSE file for more information.
+ */
+
+/**
+ ** \file runner/scheduler-stats.hh
+ ** \brief Definition of runner::SchedulerStats.
+ */
+
+#ifndef RUNNER_SCHEDULER_STATS_HH
+# define RUNNER_SCHEDULER_STATS_HH
+
+# include <cstddef>
+# include <iosfwd>
+# include <string>
+# include <utility>
+# include <vector>
+
+# include <libport/utime.hh>
+
+namespace runner
+{
+  class Job;
+
+  /// Instrumentation of the scheduler, to find what breaks a deadline:
+  /// durations of the cycles and of the slices during which a job runs
+  /// until it yields, job events per cycle, and the jobs that ran the
+  /// longest slices.  The last cycles are kept in a trace.
+  ///
+  /// The kernel runs one job at a time, so the current cycle and slice
+  /// are global.
+  class SchedulerStats
+  {
+  public:
+    /// Power-of-two histogram of durations.
+    class Histogram
+    {
+    public:
+      /// Bucket 0 counts the durations below 1us, bucket i the ones in
+      /// [2^(i-1), 2^i) us, and the last bucket all the longer ones.
+      static const unsigned size = 24;
+
+      Histogram();
+      void add(libport::utime_t d);
+      void reset();
+      size_t operator[](unsigned i) const;
+
+    private:
+      size_t buckets_[size];
+    };
+
+    /// The summary of a cycle.
+    struct Cycle
+    {
+      Cycle();
+      /// When the cycle started, and its duration, in microseconds.
+      libport::utime_t start;
+      libport::utime_t duration;
+      /// Number of jobs resumed, of jobs that yielded, and of jobs
+      /// found frozen.  A job is counted once per cycle, however many
+      /// times the scheduler checks it.
+      unsigned resumed;
+      unsigned yielded;
+      unsigned frozen;
+      /// The longest slice, and the name of its job.
+      libport::utime_t slice_max;
+      std::string job;
+    };
+
+    /// \name Scheduler hooks.
+    /// \{
+    static void cycle_begin(libport::utime_t now);
+    static void cycle_end(libport::utime_t now);
+    /// \a job starts running.
+    static void resumed(const Job& job);
+    /// \a job yields.
+    static void preempted(const Job& job);
+    /// \a job terminates, possibly without yielding.
+    static void terminated(const Job& job);
+    /// The scheduler found a frozen job, whose \a counted is the last
+    /// cycle it was counted in.
+    static void frozen(size_t& counted);
+    /// \}
+
+    /// \name Statistics.
+    /// \{
+    /// Durations of the cycles.
+    static Histogram cycles;
+    /// Durations of the slices.
+    static Histogram slices;
+    /// Job events since the last reset.
+    static size_t resumed_total;
+    static size_t yielded_total;
+    static size_t frozen_total;
+    /// Most job events in a cycle.
+    static unsigned resumed_max;
+    static unsigned yielded_max;
+    static unsigned frozen_max;
+
+    /// The longest slice of the jobs that ran the longest slices, in
+    /// decreasing order.
+    typedef std::vector<std::pair<std::string, libport::utime_t> > jobs_type;
+    static const jobs_type& worst_jobs();
+    /// Number of jobs kept in worst_jobs.
+    static const size_t worst_size = 8;
+
+    /// Reset the counters and the trace.
+    static void stats_reset();
+    /// \}
+
+    /// \name Trace.
+    /// \{
+    /// Number of cycles kept.
+    static const size_t trace_size = 4096;
+    /// Write the trace of the last cycles, oldest first, as CSV.
+    /// \return the number of cycles written.
+    static size_t trace_dump(std::ostream& o);
+    /// \}
+
+  private:
+    /// Close the running slice, and attribute it to its job.
+    static void slice_end(libport::utime_t now);
+
+    static Cycle cycle_;
+    static jobs_type worst_;
+    /// Start of the running slice, 0 if none.
+    static libport::utime_t slice_start_;
+    /// The job of the running slice, 0 if none.
+    static const Job* slice_job_;
+    /// Number of the current cycle, starting at 1.
+    static size_t cycle_number_;
+
+    typedef std::vector<Cycle> trace_type;
+    static trace_type trace_;
+    /// Where the next cycle goes in the trace.
+    static size_t trace_next_;
+  };
+}
+
+# include <runner/scheduler-stats.hxx>
+
+#endif // !RUNNER_SCHEDULER_STATS_HH
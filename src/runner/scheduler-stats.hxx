@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2012, Gostai S.A.S.
+ *
+ * This software is provided "as is" without warranty of any kind,
+ * either expressed or implied, including but not limited to the
+ * implied warranties of fitness for a particular purpose.
+ *
+ * See the LICENSE file for more information.
+ */
+
+/**
+ ** \file runner/scheduler-stats.hxx
+ ** \brief Inline implementation of runner::SchedulerStats.
+ */
+
+#ifndef RUNNER_SCHEDULER_STATS_HXX
+# define RUNNER_SCHEDULER_STATS_HXX
+
+# include <runner/scheduler-stats.hh>
+
+namespace runner
+{
+  /*----------------------------.
+  | SchedulerStats::Histogram.  |
+  `----------------------------*/
+
+  inline void
+  SchedulerStats::Histogram::add(libport::utime_t d)
+  {
+    unsigned i = 0;
+    while (d && i < size - 1)
+    {
+      d >>= 1;
+      ++i;
+    }
+    ++buckets_[i];
+  }
+
+  inline size_t
+  SchedulerStats::Histogram::operator[](unsigned i) const
+  {
+    return buckets_[i];
+  }
+
+
+  /*-----------------.
+  | SchedulerStats.  |
+  `-----------------*/
+
+  inline void
+  SchedulerStats::resumed(const Job& job)
+  {
+    libport::utime_t now = libport::utime();
+    // The previous job neither yielded nor reported its termination.
+    if (slice_start_)
+      slice_end(now);
+    slice_start_ = now;
+    slice_job_ = &job;
+    ++cycle_.resumed;
+  }
+
+  inline void
+  SchedulerStats::preempted(const Job& job)
+  {
+    ++cycle_.yielded;
+    // No matching resumed().
+    if (!slice_start_ || slice_job_ != &job)
+      return;
+    slice_end(libport::utime());
+  }
+
+  inline void
+  SchedulerStats::terminated(const Job& job)
+  {
+    if (slice_start_ && slice_job_ == &job)
+      slice_end(libport::utime());
+  }
+
+  inline void
+  SchedulerStats::frozen(size_t& counted)
+  {
+    if (counted == cycle_number_)
+      return;
+    counted = cycle_number_;
+    ++cycle_.frozen;
+  }
+
+  inline const SchedulerStats::jobs_type&
+  SchedulerStats::worst_jobs()
+  {
+    return worst_;
+  }
+}
+
+#endif // !RUNNER_SCHEDULER_STATS_HXX
@@ -105,9 +105,8 @@ namespace runner
     rObject this_get();
     /// Get 'call'.
     rObject call();
-
-  private:
-    /// Factored helpers for both rget.
+    /// Get slot \a index from the local frame if \a depth is null,
+    /// from the captured one otherwise.  Factors both rget above.
     Stacks::rSlot
     rget(libport::Symbol name, unsigned index, unsigned depth);
 
@@ -242,6 +242,8 @@ namespace runner
     /// Get slot from the stack.
     rSlot
     rget_assignment(ast::rConstLocalAssignment e);
+    /// Get slot from the stack, by coordinates.
+    rSlot rget(libport::Symbol name, unsigned index, unsigned depth);
     /// Get 'this'.
     rObject this_get();
     /// Get 'call'.
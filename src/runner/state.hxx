@@ -256,6 +256,13 @@ namespace runner
     return stacks_.rget_assignment(e);
   }
 
+  LIBPORT_SPEED_ALWAYS_INLINE
+  State::rSlot
+  State::rget(libport::Symbol name, unsigned index, unsigned depth)
+  {
+    return stacks_.rget(name, index, depth);
+  }
+
   LIBPORT_SPEED_ALWAYS_INLINE
   State::rObject
   State::this_get()
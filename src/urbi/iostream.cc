@@ -87,6 +87,14 @@ namespace urbi
     return res;
   }
 
+  std::streamsize
+  StreamBuffer::showmanyc()
+  {
+    if (buffer_write_->used)
+      return buffer_write_->used;
+    return close_ ? -1 : 0;
+  }
+
   void
   StreamBuffer::post_data(const std::string& data)
   {
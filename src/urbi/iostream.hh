@@ -35,6 +35,9 @@ namespace urbi
 
   protected:
     virtual int underflow();
+    /// The number of bytes posted but not yet handed to the reader,
+    /// so that readsome fetches them without a round-trip by peek.
+    virtual std::streamsize showmanyc();
 
     virtual int overflow(int c);
     virtual int sync();